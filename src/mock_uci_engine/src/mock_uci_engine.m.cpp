@@ -0,0 +1,408 @@
+#include <fmt/format.h>
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Deterministic stand-in for a UCI engine:
+//   mock_uci_engine [--think <ms>] [--info <lines>] [--moves <m1,m2,...>]
+//       [--fail <stall|exit>] [--fail-marker <file>] [--ponder <wait|early>]
+// Every search emits the given number of info lines at once, thinks for the
+// given time and plays the next move of the script, wrapping around. The
+// move after it is reported as the ponder move. Each info line is reported
+// for every variation of the MultiPV setting.
+// A failing engine never answers its first search or exits when it receives
+// it. With a marker file only the process which creates the file fails, so
+// an engine which is started again recovers.
+// An early pondering engine doesn't wait for ponderhit, as some engines
+// don't.
+
+namespace
+{
+    enum class failure : uint8_t
+    {
+        none,
+        stall,
+        exit
+    };
+
+    struct [[nodiscard]] mock_options final
+    {
+        std::chrono::milliseconds think_time{};
+        uint32_t info_lines{};
+        std::vector<std::string> moves{"e2e4"};
+        failure fail{failure::none};
+        std::filesystem::path fail_marker;
+        bool early_ponder{false};
+    };
+
+    template<typename T>
+    [[nodiscard]] std::optional<T> parse_number(std::string_view const value)
+    {
+        T rv; // NOLINT
+        auto const [end, error]{
+            std::from_chars(value.data(), value.data() + value.size(), rv)};
+        if (error != std::errc{} || end != value.data() + value.size())
+        {
+            return std::nullopt;
+        }
+        return rv;
+    }
+
+    [[nodiscard]] std::vector<std::string> split_moves(std::string_view value)
+    {
+        std::vector<std::string> rv;
+        while (!value.empty())
+        {
+            size_t const separator{value.find(',')};
+            if (std::string_view const move{value.substr(0, separator)};
+                !move.empty())
+            {
+                rv.emplace_back(move);
+            }
+
+            if (separator == std::string_view::npos)
+            {
+                break;
+            }
+            value.remove_prefix(separator + 1);
+        }
+        return rv;
+    }
+
+    [[nodiscard]] std::optional<mock_options> parse_options(int const argc,
+        char** const argv)
+    {
+        mock_options rv;
+        for (int i{1}; i + 1 < argc; i += 2)
+        {
+            std::string_view const name{argv[i]};
+            std::string_view const value{argv[i + 1]};
+            if (name == "--think")
+            {
+                auto const think{parse_number<uint32_t>(value)};
+                if (!think)
+                {
+                    return std::nullopt;
+                }
+                rv.think_time = std::chrono::milliseconds{*think};
+            }
+            else if (name == "--info")
+            {
+                auto const lines{parse_number<uint32_t>(value)};
+                if (!lines)
+                {
+                    return std::nullopt;
+                }
+                rv.info_lines = *lines;
+            }
+            else if (name == "--moves")
+            {
+                rv.moves = split_moves(value);
+                if (rv.moves.empty())
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (name == "--fail")
+            {
+                if (value == "stall")
+                {
+                    rv.fail = failure::stall;
+                }
+                else if (value == "exit")
+                {
+                    rv.fail = failure::exit;
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (name == "--fail-marker")
+            {
+                rv.fail_marker = value;
+            }
+            else if (name == "--ponder")
+            {
+                if (value != "wait" && value != "early")
+                {
+                    return std::nullopt;
+                }
+                rv.early_ponder = value == "early";
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        if (argc % 2 == 0)
+        {
+            return std::nullopt;
+        }
+
+        return rv;
+    }
+
+    constexpr std::array<std::string_view, 8> handshake{
+        "id name mock_uci_engine",
+        "id author pawn",
+        "option name Threads type spin default 1 min 1 max 1024",
+        "option name Hash type spin default 16 min 1 max 33554432",
+        "option name MultiPV type spin default 1 min 1 max 256",
+        "option name Move Overhead type spin default 10 min 0 max 5000",
+        "option name Ponder type check default false",
+        "uciok"};
+
+    constexpr std::string_view multipv_option{
+        "setoption name MultiPV value "};
+
+    // Creating the marker is atomic, one of the processes sharing it fails
+    [[nodiscard]] bool claim_failure(mock_options const& options)
+    {
+        if (options.fail == failure::none)
+        {
+            return false;
+        }
+
+        if (options.fail_marker.empty())
+        {
+            return true;
+        }
+
+        std::FILE* const marker{
+            std::fopen(options.fail_marker.string().c_str(), "wx")};
+        if (!marker)
+        {
+            return false;
+        }
+        std::fclose(marker);
+        return true;
+    }
+
+    // Lines are written by both the command loop and the search thread
+    class [[nodiscard]] output final
+    {
+    public:
+        void write(std::string_view const line)
+        {
+            std::lock_guard const lock{mutex_};
+            std::fwrite(line.data(), 1, line.size(), stdout);
+            std::fputc('\n', stdout);
+            std::fflush(stdout);
+        }
+
+    private:
+        std::mutex mutex_;
+    };
+
+    class [[nodiscard]] search final
+    {
+    public:
+        // Ponder and infinite searches think only after being released
+        search(output& out,
+            mock_options const& options,
+            uint32_t multipv,
+            std::string move,
+            std::string ponder,
+            bool wait_for_release)
+            : out_{&out}
+            , options_{&options}
+            , multipv_{multipv}
+            , move_{std::move(move)}
+            , ponder_{std::move(ponder)}
+            , released_{!wait_for_release}
+            , thread_{[this](std::stop_token const& token) { run(token); }}
+        {
+        }
+
+        search(search const&) = delete;
+
+        search(search&&) noexcept = delete;
+
+    public:
+        ~search() = default;
+
+    public:
+        void stop() { thread_.request_stop(); }
+
+        void release()
+        {
+            {
+                std::lock_guard const lock{mutex_};
+                released_ = true;
+            }
+            released_condition_.notify_all();
+        }
+
+    public:
+        search& operator=(search const&) = delete;
+
+        search& operator=(search&&) noexcept = delete;
+
+    private:
+        void run(std::stop_token const& token)
+        {
+            for (uint32_t i{}; i != options_->info_lines; ++i)
+            {
+                for (uint32_t variation{1}; variation <= multipv_; ++variation)
+                {
+                    out_->write(fmt::format("info depth {} seldepth {} "
+                                            "multipv {} score cp {} nodes {} "
+                                            "nps 1000000 time {} pv {} {}",
+                        i % 64 + 1,
+                        i % 64 + 8,
+                        variation,
+                        static_cast<int32_t>(i % 50) - 25,
+                        uint64_t{i} * 1000,
+                        i,
+                        move_,
+                        ponder_));
+                }
+            }
+
+            {
+                std::unique_lock lock{mutex_};
+                if (released_condition_.wait(lock,
+                        token,
+                        [this]() { return released_; }))
+                {
+                    released_condition_.wait_for(lock,
+                        token,
+                        options_->think_time,
+                        []() { return false; });
+                }
+            }
+
+            out_->write(fmt::format("bestmove {} ponder {}", move_, ponder_));
+        }
+
+    private:
+        output* out_;
+        mock_options const* options_;
+        uint32_t multipv_;
+        std::string move_;
+        std::string ponder_;
+
+        std::mutex mutex_;
+        std::condition_variable_any released_condition_;
+        bool released_;
+
+        std::jthread thread_;
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::optional<mock_options> const options{parse_options(argc, argv)};
+    if (!options)
+    {
+        std::cerr << "usage: mock_uci_engine [--think <ms>] [--info <lines>] "
+                     "[--moves <m1,m2,...>] [--fail <stall|exit>] "
+                     "[--fail-marker <file>] [--ponder <wait|early>]\n";
+        return EXIT_FAILURE;
+    }
+
+    output out;
+    std::unique_ptr<search> current;
+    size_t next_move{};
+    uint32_t multipv{1};
+    bool failing{claim_failure(*options)};
+
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        std::string_view const command{line};
+        if (command == "uci")
+        {
+            for (std::string_view const handshake_line : handshake)
+            {
+                out.write(handshake_line);
+            }
+        }
+        else if (command == "isready")
+        {
+            out.write("readyok");
+        }
+        else if (command == "ucinewgame")
+        {
+            next_move = 0;
+        }
+        else if (command.starts_with(multipv_option))
+        {
+            std::string_view const value{
+                command.substr(multipv_option.size())};
+            multipv = parse_number<uint32_t>(value).value_or(1);
+        }
+        else if (command.starts_with("go"))
+        {
+            current.reset();
+
+            if (std::exchange(failing, false))
+            {
+                if (options->fail == failure::exit)
+                {
+                    return EXIT_FAILURE;
+                }
+                continue;
+            }
+
+            bool const wait_for_release{
+                (command.find(" ponder") != std::string_view::npos &&
+                    !options->early_ponder) ||
+                command.find(" infinite") != std::string_view::npos};
+
+            std::vector<std::string> const& moves{options->moves};
+            current = std::make_unique<search>(out,
+                *options,
+                multipv,
+                moves[next_move % moves.size()],
+                moves[(next_move + 1) % moves.size()],
+                wait_for_release);
+            ++next_move;
+        }
+        else if (command == "ponderhit")
+        {
+            if (current)
+            {
+                current->release();
+            }
+        }
+        else if (command == "stop")
+        {
+            if (current)
+            {
+                current->stop();
+                current.reset();
+            }
+        }
+        else if (command == "quit")
+        {
+            break;
+        }
+    }
+
+    if (current)
+    {
+        current->stop();
+    }
+
+    return EXIT_SUCCESS;
+}
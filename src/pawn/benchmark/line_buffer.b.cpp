@@ -0,0 +1,95 @@
+#include <line_buffer.hpp>
+
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/streambuf.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    // Output of a MultiPV search, read in chunks the size of a pipe buffer
+    constexpr size_t chunk_size{4096};
+
+    [[nodiscard]] std::string engine_output(size_t const lines)
+    {
+        std::string rv;
+        for (size_t i{}; i != lines; ++i)
+        {
+            fmt::format_to(std::back_inserter(rv),
+                "info depth 24 seldepth 33 multipv {} score cp {} nodes "
+                "12903741 nps 1204512 hashfull 533 tbhits 0 time 10713 pv e2e4 "
+                "e7e5 g1f3 b8c6 f1b5 a7a6 b5a4 g8f6 e1g1 f8e7\n",
+                i % 8 + 1,
+                static_cast<int>(i % 50) - 25);
+        }
+        return rv;
+    }
+} // namespace
+
+TEST_CASE("line reader", "[!benchmark][uci]")
+{
+    std::string const output{engine_output(2000)};
+
+    BENCHMARK("streambuf getline trim")
+    {
+        boost::asio::streambuf buffer;
+        std::istream stream{&buffer};
+
+        size_t length{};
+        for (size_t offset{}; offset < output.size();)
+        {
+            size_t const bytes{std::min(chunk_size, output.size() - offset)};
+            auto const space{buffer.prepare(bytes)};
+            boost::asio::buffer_copy(space,
+                boost::asio::buffer(output.data() + offset, bytes));
+            buffer.commit(bytes);
+            offset += bytes;
+
+            while (std::string_view{
+                       static_cast<char const*>(buffer.data().data()),
+                       buffer.size()}
+                       .contains('\n'))
+            {
+                std::string line;
+                std::getline(stream, line);
+                boost::algorithm::trim(line);
+                length += line.size();
+            }
+        }
+        return length;
+    };
+
+    BENCHMARK("line_buffer")
+    {
+        pawn::line_buffer buffer;
+
+        size_t length{};
+        for (size_t offset{}; offset < output.size();)
+        {
+            std::span<char> const space{buffer.prepare()};
+            size_t const bytes{
+                std::min({chunk_size, output.size() - offset, space.size()})};
+            std::copy_n(output.data() + offset, bytes, space.data());
+            buffer.commit(bytes);
+            offset += bytes;
+
+            while (auto const line{buffer.next_line()})
+            {
+                length += line->size();
+            }
+        }
+        return length;
+    };
+}
@@ -0,0 +1,76 @@
+#include <position_command.hpp>
+#include <uci_move.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    [[nodiscard]] std::vector<std::string> game(size_t const plies)
+    {
+        constexpr std::array<std::string_view, 8> shuffle{"g1f3",
+            "g8f6",
+            "f3g1",
+            "f6g8",
+            "b1c3",
+            "b8c6",
+            "c3b1",
+            "c6b8"};
+
+        std::vector<std::string> rv;
+        rv.reserve(plies);
+        for (size_t i{}; i != plies; ++i)
+        {
+            rv.emplace_back(shuffle[i % shuffle.size()]);
+        }
+        return rv;
+    }
+} // namespace
+
+TEST_CASE("position command", "[!benchmark][uci]")
+{
+    for (size_t const plies : {40, 120, 320})
+    {
+        std::vector<std::string> const moves{game(plies)};
+
+        std::vector<pawn::uci_move> packed;
+        packed.reserve(moves.size());
+        for (std::string const& move : moves)
+        {
+            packed.push_back(pawn::parse_move(move).value());
+        }
+
+        BENCHMARK(fmt::format("fmt::format {} plies", plies))
+        {
+            size_t length{};
+            for (size_t i{1}; i <= moves.size(); ++i)
+            {
+                length += fmt::format("position startpos moves {}",
+                    fmt::join(std::span{moves}.first(i), " "))
+                              .size();
+            }
+            return length;
+        };
+
+        BENCHMARK(fmt::format("position_command {} plies", plies))
+        {
+            pawn::position_command command;
+
+            size_t length{};
+            for (size_t i{1}; i <= packed.size(); ++i)
+            {
+                length += command.update(std::span{packed}.first(i)).size();
+            }
+            return length;
+        };
+    }
+}
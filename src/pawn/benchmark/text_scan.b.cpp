@@ -0,0 +1,127 @@
+#include <line_buffer.hpp>
+#include <text_scan.hpp>
+#include <uci_ast.hpp>
+#include <uci_tokenizer.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Output of a MultiPV 256 search with UCI_ShowWDL, split into lines and
+// parsed with each kernel supported by the processor
+
+namespace
+{
+    constexpr size_t chunk_size{4096};
+
+    [[nodiscard]] std::string engine_output(size_t const lines)
+    {
+        std::string rv;
+        for (size_t i{}; i != lines; ++i)
+        {
+            fmt::format_to(std::back_inserter(rv),
+                "info depth 31 seldepth 44 multipv {} score cp {} wdl {} {} "
+                "{} nodes 281902374 nps 2104512 hashfull 871 tbhits 0 time "
+                "133958 pv e2e4 e7e5 g1f3 b8c6 f1b5 a7a6 b5a4 g8f6 e1g1 f8e7 "
+                "f1e1 b7b5 a4b3 d7d6 c2c3 e8g8 h2h3 c6a5 b3c2 c7c5 d2d4\n",
+                i % 256 + 1,
+                static_cast<int>(i % 50) - 25,
+                120 + i % 7,
+                780 - i % 7,
+                100);
+        }
+        return rv;
+    }
+
+    [[nodiscard]] std::string_view name(pawn::scan_kernel const kernel)
+    {
+        switch (kernel)
+        {
+        case pawn::scan_kernel::scalar:
+            return "scalar";
+        case pawn::scan_kernel::sse2:
+            return "sse2";
+        case pawn::scan_kernel::avx2:
+            return "avx2";
+        }
+        return "unknown";
+    }
+} // namespace
+
+TEST_CASE("text scan", "[!benchmark][uci]")
+{
+    std::string const output{engine_output(2560)};
+    pawn::scan_kernel const detected{pawn::selected_scan_kernel()};
+
+    for (pawn::scan_kernel const kernel : {pawn::scan_kernel::scalar,
+             pawn::scan_kernel::sse2,
+             pawn::scan_kernel::avx2})
+    {
+        if (!pawn::select_scan_kernel(kernel))
+        {
+            continue;
+        }
+
+        BENCHMARK(fmt::format("{} split {} bytes", name(kernel), output.size()))
+        {
+            pawn::line_buffer buffer;
+
+            size_t lines{};
+            for (size_t offset{}; offset < output.size();)
+            {
+                std::span<char> const space{buffer.prepare()};
+                size_t const bytes{std::min(
+                    {chunk_size, output.size() - offset, space.size()})};
+                std::copy_n(output.data() + offset, bytes, space.data());
+                buffer.commit(bytes);
+                offset += bytes;
+
+                while (buffer.next_line())
+                {
+                    ++lines;
+                }
+            }
+            return lines;
+        };
+
+        BENCHMARK(fmt::format("{} split and parse {} bytes",
+            name(kernel),
+            output.size()))
+        {
+            pawn::line_buffer buffer;
+            pawn::ast::info info{};
+
+            size_t parsed{};
+            for (size_t offset{}; offset < output.size();)
+            {
+                std::span<char> const space{buffer.prepare()};
+                size_t const bytes{std::min(
+                    {chunk_size, output.size() - offset, space.size()})};
+                std::copy_n(output.data() + offset, bytes, space.data());
+                buffer.commit(bytes);
+                offset += bytes;
+
+                while (auto const line{buffer.next_line()})
+                {
+                    pawn::uci_tokenizer tokens{*line};
+                    if (pawn::classify(tokens) == pawn::uci_message::info)
+                    {
+                        pawn::parse_info(tokens, info);
+                        ++parsed;
+                    }
+                }
+            }
+            return parsed;
+        };
+    }
+
+    CHECK(pawn::select_scan_kernel(detected));
+}
@@ -0,0 +1,155 @@
+#include <search_limits.hpp>
+#include <uci_engine.hpp>
+#include <uci_move.hpp>
+#include <uci_reactor.hpp>
+#include <uci_session.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Pings would interleave with the measured commands
+    constexpr pawn::watchdog_options quiet_watchdog{.heartbeat = 0ms};
+
+    [[nodiscard]] std::string mock_engine(std::string_view const arguments)
+    {
+        return fmt::format("\"{}\" {}", PAWN_MOCK_UCI_ENGINE, arguments);
+    }
+
+    [[nodiscard]] pawn::search_result search(pawn::uci_engine& engine,
+        std::vector<pawn::uci_move> const& moves)
+    {
+        std::promise<pawn::search_result> result;
+        std::future<pawn::search_result> future{result.get_future()};
+        engine.next_move(moves,
+            {.depth = 1},
+            [&result](pawn::search_result r)
+            { result.set_value(std::move(r)); });
+        return future.get();
+    }
+
+    boost::asio::awaitable<void> search_repeatedly(pawn::uci_session session,
+        std::vector<pawn::uci_move> const moves,
+        uint32_t const searches,
+        uint32_t& completed)
+    {
+        for (uint32_t i{}; i != searches; ++i)
+        {
+            pawn::search_result const result{
+                co_await session.go(moves, {.depth = 1})};
+            completed += result.move.has_value();
+        }
+    }
+} // namespace
+
+TEST_CASE("engine round trip", "[!benchmark][uci]")
+{
+    pawn::uci_reactor reactor;
+    pawn::uci_engine engine{mock_engine("--moves e2e4,e7e5"),
+        reactor,
+        {},
+        quiet_watchdog};
+    engine.wait_until_ready();
+
+    std::vector const moves{pawn::parse_move("d2d4").value(),
+        pawn::parse_move("d7d5").value()};
+    CHECK(search(engine, moves).move);
+
+    BENCHMARK("isready readyok") { engine.synchronize(); };
+
+    BENCHMARK("go bestmove") { return search(engine, moves).move; };
+}
+
+TEST_CASE("engine startup", "[!benchmark][uci]")
+{
+    std::string const command_line{mock_engine("--moves e2e4,e7e5")};
+
+    pawn::uci_reactor reactor;
+    pawn::uci_engine engine{command_line, reactor, {}, quiet_watchdog};
+    engine.wait_until_ready();
+
+    BENCHMARK("spawn and handshake")
+    {
+        pawn::uci_engine started{command_line, reactor, {}, quiet_watchdog};
+        started.wait_until_ready();
+    };
+
+    BENCHMARK("ucinewgame isready") { engine.new_game(); };
+}
+
+TEST_CASE("engine info throughput", "[!benchmark][uci]")
+{
+    constexpr uint32_t info_lines{2000};
+
+    pawn::uci_reactor reactor;
+    pawn::uci_engine engine{mock_engine(fmt::format("--info {}", info_lines)),
+        reactor,
+        {},
+        quiet_watchdog};
+    engine.wait_until_ready();
+
+    std::vector const moves{pawn::parse_move("e2e4").value()};
+    CHECK(search(engine, moves).move);
+    CHECK(engine.search_telemetry().size() == info_lines);
+
+    // Lines per second are info_lines divided by the mean
+    BENCHMARK("2000 info lines") { return search(engine, moves).move; };
+}
+
+TEST_CASE("engine sessions", "[!benchmark][uci]")
+{
+    constexpr uint32_t sessions{32};
+    constexpr uint32_t searches{10};
+
+    pawn::uci_reactor reactor;
+    std::vector<std::unique_ptr<pawn::uci_engine>> engines;
+    for (uint32_t i{}; i != sessions; ++i)
+    {
+        engines.push_back(
+            std::make_unique<pawn::uci_engine>(mock_engine("--moves e7e5"),
+                reactor,
+                pawn::option_profile{},
+                quiet_watchdog));
+    }
+
+    std::vector const moves{pawn::parse_move("e2e4").value()};
+
+    // Every conversation is a coroutine on the thread of the benchmark
+    BENCHMARK(fmt::format("{} sessions {} searches each", sessions, searches))
+    {
+        boost::asio::io_context context{1};
+
+        uint32_t completed{};
+        for (std::unique_ptr<pawn::uci_engine> const& engine : engines)
+        {
+            boost::asio::co_spawn(context,
+                search_repeatedly(pawn::uci_session{*engine},
+                    moves,
+                    searches,
+                    completed),
+                boost::asio::detached);
+        }
+        context.run();
+        return completed;
+    };
+}
@@ -0,0 +1,138 @@
+#include <uci_ast.hpp>
+#include <uci_parser.hpp>
+#include <uci_tokenizer.hpp>
+
+#include <boost/spirit/home/x3.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The grammar rules are instantiated for string_view iterators. Every
+// benchmark parses a batch of lines, lines per second are the batch size
+// divided by the reported mean.
+
+namespace
+{
+    constexpr size_t batch_size{1000};
+
+    [[nodiscard]] std::vector<std::string> info_lines()
+    {
+        std::vector<std::string> rv;
+        rv.reserve(batch_size);
+        for (size_t i{}; i != batch_size; ++i)
+        {
+            rv.push_back(fmt::format(
+                "info depth 24 seldepth 33 multipv {} score cp {} nodes "
+                "12903741 nps 1204512 hashfull 533 tbhits 0 time 10713 pv e2e4 "
+                "e7e5 g1f3 b8c6 f1b5 a7a6 b5a4 g8f6 e1g1 f8e7",
+                i % 8 + 1,
+                static_cast<int>(i % 50) - 25));
+        }
+        return rv;
+    }
+
+    [[nodiscard]] std::vector<std::string> repeated(std::string_view line)
+    {
+        return std::vector<std::string>(batch_size, std::string{line});
+    }
+} // namespace
+
+TEST_CASE("uci parser", "[!benchmark][uci]")
+{
+    using boost::spirit::x3::ascii::space;
+
+    std::vector<std::string> const infos{info_lines()};
+
+    BENCHMARK(fmt::format("x3 info {} lines", batch_size))
+    {
+        size_t parsed{};
+        pawn::ast::info info{};
+        for (std::string const& line : infos)
+        {
+            info = {};
+            std::string_view const view{line};
+            parsed += phrase_parse(view.cbegin(),
+                view.cend(),
+                pawn::info(),
+                space,
+                info);
+        }
+        return parsed;
+    };
+
+    BENCHMARK(fmt::format("tokenizer info {} lines", batch_size))
+    {
+        size_t parsed{};
+        pawn::ast::info info{};
+        for (std::string const& line : infos)
+        {
+            parsed += pawn::parse_info(line, info);
+        }
+        return parsed;
+    };
+
+    std::vector<std::string> const bestmoves{
+        repeated("bestmove g1f3 ponder d7d5")};
+
+    BENCHMARK(fmt::format("x3 bestmove {} lines", batch_size))
+    {
+        size_t parsed{};
+        for (std::string const& line : bestmoves)
+        {
+            pawn::ast::bestmove bestmove;
+            std::string_view const view{line};
+            parsed += phrase_parse(view.cbegin(),
+                view.cend(),
+                pawn::bestmove(),
+                space,
+                bestmove);
+        }
+        return parsed;
+    };
+
+    BENCHMARK(fmt::format("tokenizer bestmove {} lines", batch_size))
+    {
+        size_t parsed{};
+        for (std::string const& line : bestmoves)
+        {
+            parsed += pawn::parse_bestmove(line).has_value();
+        }
+        return parsed;
+    };
+
+    std::vector<std::string> const options{repeated(
+        "option name Skill Level type spin default 20 min 0 max 20")};
+
+    BENCHMARK(fmt::format("x3 option {} lines", batch_size))
+    {
+        size_t parsed{};
+        for (std::string const& line : options)
+        {
+            pawn::ast::option option{};
+            std::string_view const view{line};
+            parsed += phrase_parse(view.cbegin(),
+                view.cend(),
+                pawn::option(),
+                space,
+                option);
+        }
+        return parsed;
+    };
+
+    BENCHMARK(fmt::format("tokenizer option {} lines", batch_size))
+    {
+        size_t parsed{};
+        for (std::string const& line : options)
+        {
+            parsed += pawn::parse_option(line).has_value();
+        }
+        return parsed;
+    };
+}
@@ -0,0 +1,343 @@
+#include <analysis_cache.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+namespace bi = boost::interprocess;
+
+namespace
+{
+    constexpr uint64_t magic{0x4548434143574150}; // PAWCACHE
+    constexpr uint64_t version{3};
+
+    // Entries are looked for in this many slots after the home slot
+    constexpr size_t probe_length{8};
+
+    struct [[nodiscard]] file_header final
+    {
+        uint64_t magic;
+        uint64_t version;
+        uint64_t capacity;
+        std::array<uint64_t, 5> reserved;
+    };
+
+    // Odd sequence while an entry is written, a zero key marks an empty
+    // slot. Fields are accessed atomically because other processes may
+    // write them at any time.
+    struct [[nodiscard]] slot final
+    {
+        uint64_t sequence;
+        uint64_t key;
+        uint64_t nodes;
+        // Score in the low 32 bits, depth in the next 8, then the mate flag
+        uint64_t evaluation;
+        // Best move in the low 16 bits, followed by the ponder move
+        uint64_t moves;
+    };
+
+    static_assert(sizeof(file_header) == 64);
+    static_assert(sizeof(slot) == 40);
+
+    [[nodiscard]] uint64_t load(uint64_t& value,
+        std::memory_order const order = std::memory_order_relaxed)
+    {
+        return std::atomic_ref{value}.load(order);
+    }
+
+    void store(uint64_t& value,
+        uint64_t const desired,
+        std::memory_order const order = std::memory_order_relaxed)
+    {
+        std::atomic_ref{value}.store(desired, order);
+    }
+
+    [[nodiscard]] uint64_t pack_moves(pawn::cached_analysis const& analysis)
+    {
+        return uint64_t{std::bit_cast<uint16_t>(analysis.move)} |
+            (uint64_t{std::bit_cast<uint16_t>(analysis.ponder)} << 16);
+    }
+
+    [[nodiscard]] pawn::uci_move unpacked_move(uint64_t const moves,
+        int const shift)
+    {
+        return std::bit_cast<pawn::uci_move>(
+            static_cast<uint16_t>((moves >> shift) & 0xFFFF));
+    }
+
+    [[nodiscard]] uint64_t pack_evaluation(
+        pawn::cached_analysis const& analysis)
+    {
+        return uint64_t{static_cast<uint32_t>(analysis.score)} |
+            (uint64_t{std::min<uint32_t>(analysis.depth, 0xFF)} << 32) |
+            (uint64_t{analysis.mate} << 40);
+    }
+
+    [[nodiscard]] uint32_t unpacked_depth(uint64_t const evaluation)
+    {
+        return static_cast<uint32_t>((evaluation >> 32) & 0xFF);
+    }
+
+    [[nodiscard]] bool is_valid(file_header const& header,
+        uintmax_t const size)
+    {
+        return header.magic == magic && header.version == version &&
+            std::has_single_bit(header.capacity) &&
+            size == sizeof(file_header) + header.capacity * sizeof(slot);
+    }
+
+    [[nodiscard]] bool is_cache_file(std::filesystem::path const& path)
+    {
+        std::error_code error;
+        auto const size{std::filesystem::file_size(path, error)};
+        if (error || size < sizeof(file_header))
+        {
+            return false;
+        }
+
+        file_header header{};
+        std::ifstream stream{path, std::ios::binary};
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        return stream && is_valid(header, size);
+    }
+
+    // Caches appear complete under their name, files being created by
+    // other processes are never seen or truncated. A cache created by
+    // another process meanwhile is kept, anything else is replaced.
+    void create_file(std::filesystem::path const& path, size_t const capacity)
+    {
+        std::filesystem::path temporary{path};
+        temporary += fmt::format(".{:x}.tmp", std::random_device{}());
+
+        file_header const header{.magic = magic,
+            .version = version,
+            .capacity = capacity,
+            .reserved = {}};
+
+        std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+        stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        stream.close();
+
+        std::filesystem::resize_file(temporary,
+            sizeof(file_header) + capacity * sizeof(slot));
+
+        std::error_code error;
+        std::filesystem::create_hard_link(temporary, path, error);
+        if (error && !is_cache_file(path))
+        {
+            std::filesystem::rename(temporary, path);
+        }
+        std::filesystem::remove(temporary, error);
+    }
+} // namespace
+
+class [[nodiscard]] pawn::analysis_cache::impl final
+{
+public:
+    impl(std::filesystem::path const& path, size_t const capacity)
+    {
+        if (!is_cache_file(path))
+        {
+            create_file(path, std::bit_ceil(std::max<size_t>(capacity, 1)));
+        }
+
+        file_ = bi::file_mapping{path.string().c_str(), bi::read_write};
+        region_ = bi::mapped_region{file_, bi::read_write};
+
+        auto const* const header{
+            static_cast<file_header const*>(region_.get_address())};
+        // Another process may replace an invalid file between the check
+        // and the mapping, never a valid one
+        if (region_.get_size() < sizeof(file_header) ||
+            !is_valid(*header, region_.get_size()))
+        {
+            throw std::runtime_error{
+                fmt::format("{} is not an analysis cache", path.string())};
+        }
+        slots_ = {reinterpret_cast<slot*>(
+                      static_cast<char*>(region_.get_address()) +
+                      sizeof(file_header)),
+            header->capacity};
+    }
+
+    impl(impl const&) = delete;
+
+    impl(impl&&) noexcept = delete;
+
+public:
+    ~impl() = default;
+
+public:
+    [[nodiscard]] size_t capacity() const { return slots_.size(); }
+
+    [[nodiscard]] std::optional<cached_analysis> find(uint64_t const key,
+        uint32_t const depth) const
+    {
+        for (size_t i{}; i != probe_length; ++i)
+        {
+            slot& candidate{slot_for(key, i)};
+
+            uint64_t const sequence{
+                load(candidate.sequence, std::memory_order_acquire)};
+            uint64_t const stored_key{load(candidate.key)};
+            uint64_t const nodes{load(candidate.nodes)};
+            uint64_t const evaluation{load(candidate.evaluation)};
+            uint64_t const moves{load(candidate.moves)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence % 2 != 0 || load(candidate.sequence) != sequence)
+            {
+                continue;
+            }
+
+            if (stored_key == 0)
+            {
+                return std::nullopt;
+            }
+
+            if (stored_key == key)
+            {
+                if (unpacked_depth(evaluation) < depth)
+                {
+                    return std::nullopt;
+                }
+
+                return cached_analysis{.move = unpacked_move(moves, 0),
+                    .ponder = unpacked_move(moves, 16),
+                    .score = static_cast<int32_t>(evaluation & 0xFFFFFFFF),
+                    .mate = ((evaluation >> 40) & 1) != 0,
+                    .depth = unpacked_depth(evaluation),
+                    .nodes = nodes};
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    // The same position or an empty slot is used, otherwise the shallowest
+    // analysis in the probed slots is replaced
+    void store(uint64_t const key, cached_analysis const& analysis)
+    {
+        slot* target{};
+        uint32_t target_depth{std::numeric_limits<uint32_t>::max()};
+        for (size_t i{}; i != probe_length; ++i)
+        {
+            slot& candidate{slot_for(key, i)};
+            uint64_t const stored_key{load(candidate.key)};
+            uint32_t const stored_depth{
+                unpacked_depth(load(candidate.evaluation))};
+
+            if (stored_key == key)
+            {
+                if (stored_depth > analysis.depth)
+                {
+                    return;
+                }
+                target = &candidate;
+                break;
+            }
+
+            if (stored_key == 0)
+            {
+                target = &candidate;
+                break;
+            }
+
+            if (stored_depth < target_depth)
+            {
+                target = &candidate;
+                target_depth = stored_depth;
+            }
+        }
+
+        uint64_t sequence{load(target->sequence)};
+        if (sequence % 2 != 0 ||
+            !std::atomic_ref{target->sequence}.compare_exchange_strong(
+                sequence,
+                sequence + 1,
+                std::memory_order_acquire))
+        {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        ::store(target->key, key);
+        ::store(target->nodes, analysis.nodes);
+        ::store(target->evaluation, pack_evaluation(analysis));
+        ::store(target->moves, pack_moves(analysis));
+
+        ::store(target->sequence, sequence + 2, std::memory_order_release);
+    }
+
+public:
+    impl& operator=(impl const&) = delete;
+
+    impl& operator=(impl&&) noexcept = delete;
+
+private:
+    [[nodiscard]] slot& slot_for(uint64_t const key, size_t const probe) const
+    {
+        return slots_[(key + probe) & (slots_.size() - 1)];
+    }
+
+private:
+    bi::file_mapping file_;
+    bi::mapped_region region_;
+    std::span<slot> slots_;
+};
+
+pawn::analysis_cache::analysis_cache(std::filesystem::path const& path,
+    size_t const capacity)
+    : impl_{std::make_unique<impl>(path, capacity)}
+{
+}
+
+pawn::analysis_cache::~analysis_cache() = default;
+
+uint64_t pawn::analysis_cache::key(std::string_view const configuration,
+    std::string_view const position)
+{
+    // FNV-1a, zero is reserved for empty slots. Each string is hashed as if
+    // terminated by a zero byte, "ab" "c" and "a" "bc" differ.
+    uint64_t rv{0xcbf29ce484222325};
+    for (std::string_view const text : {configuration, position})
+    {
+        for (char const c : text)
+        {
+            rv ^= static_cast<unsigned char>(c);
+            rv *= 0x100000001b3;
+        }
+        rv *= 0x100000001b3;
+    }
+    return rv == 0 ? 1 : rv;
+}
+
+size_t pawn::analysis_cache::capacity() const { return impl_->capacity(); }
+
+std::optional<pawn::cached_analysis> pawn::analysis_cache::find(
+    uint64_t const key,
+    uint32_t const depth) const
+{
+    return impl_->find(key, depth);
+}
+
+void pawn::analysis_cache::store(uint64_t const key,
+    cached_analysis const& analysis)
+{
+    impl_->store(key, analysis);
+}
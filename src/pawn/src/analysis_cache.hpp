@@ -0,0 +1,71 @@
+#ifndef PAWN_ANALYSIS_CACHE_INCLUDED
+#define PAWN_ANALYSIS_CACHE_INCLUDED
+
+#include <uci_move.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace pawn
+{
+    struct [[nodiscard]] cached_analysis final
+    {
+        uci_move move;
+        uci_move ponder;
+        int32_t score{};
+        bool mate{};
+        uint32_t depth{};
+        uint64_t nodes{};
+    };
+
+    // Open addressing table of analyses in a memory mapped file, shared
+    // between processes. Entries are guarded by sequence counters so readers
+    // never block and see either a complete entry or none. Concurrent stores
+    // to the same entry are dropped, the cache is best effort.
+    class [[nodiscard]] analysis_cache final
+    {
+    public:
+        // Creates the file if it doesn't exist or isn't a cache, otherwise
+        // keeps its capacity. Capacity is rounded up to a power of two.
+        explicit analysis_cache(std::filesystem::path const& path,
+            size_t capacity = size_t{1} << 20);
+
+        analysis_cache(analysis_cache const&) = delete;
+
+        analysis_cache(analysis_cache&&) noexcept = delete;
+
+    public:
+        ~analysis_cache();
+
+    public:
+        // Hash of the position command which set up the position, for an
+        // engine with the given command line and options. Analyses of other
+        // engines or settings sharing the file are never found.
+        [[nodiscard]] static uint64_t key(std::string_view configuration,
+            std::string_view position);
+
+        [[nodiscard]] size_t capacity() const;
+
+        // Empty unless the entry was searched at least to the given depth
+        [[nodiscard]] std::optional<cached_analysis> find(uint64_t key,
+            uint32_t depth) const;
+
+        // Keeps the deeper analysis of the same position
+        void store(uint64_t key, cached_analysis const& analysis);
+
+    public:
+        analysis_cache& operator=(analysis_cache const&) = delete;
+
+        analysis_cache& operator=(analysis_cache&&) noexcept = delete;
+
+    private:
+        class impl;
+        std::unique_ptr<impl> impl_;
+    };
+} // namespace pawn
+
+#endif
@@ -22,6 +22,19 @@ namespace pawn
         white,
         black
     };
+
+    [[nodiscard]] constexpr piece_color opposite(piece_color const color)
+    {
+        switch (color)
+        {
+        case piece_color::white:
+            return piece_color::black;
+        case piece_color::black:
+            return piece_color::white;
+        default:
+            return piece_color::none;
+        }
+    }
 } // namespace pawn
 
 #endif // !PAWN_CHESS_INCLUDED
@@ -0,0 +1,188 @@
+#include <chess_clock.hpp>
+
+#include <cassert>
+#include <charconv>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+    [[nodiscard]] std::optional<std::chrono::milliseconds> parse_seconds(
+        std::string_view const value)
+    {
+        auto const separator{value.find('.')};
+        std::string_view const whole{value.substr(0, separator)};
+        std::string_view const fraction{separator == std::string_view::npos
+                ? std::string_view{}
+                : value.substr(separator + 1)};
+        if (whole.empty() && fraction.empty())
+        {
+            return std::nullopt;
+        }
+
+        int64_t seconds{};
+        if (!whole.empty())
+        {
+            auto const [end, error]{std::from_chars(whole.data(),
+                whole.data() + whole.size(),
+                seconds)};
+            if (error != std::errc{} || end != whole.data() + whole.size())
+            {
+                return std::nullopt;
+            }
+        }
+
+        int64_t milliseconds{};
+        int64_t scale{100};
+        for (char const digit : fraction)
+        {
+            if (digit < '0' || digit > '9')
+            {
+                return std::nullopt;
+            }
+            milliseconds += (digit - '0') * scale;
+            scale /= 10;
+        }
+
+        return std::chrono::milliseconds{seconds * 1000 + milliseconds};
+    }
+} // namespace
+
+std::optional<pawn::time_control> pawn::parse_time_control(
+    std::string_view value)
+{
+    time_control rv;
+
+    if (auto const separator{value.find('/')};
+        separator != std::string_view::npos)
+    {
+        std::string_view const moves{value.substr(0, separator)};
+        auto const [end, error]{std::from_chars(moves.data(),
+            moves.data() + moves.size(),
+            rv.moves_per_period)};
+        if (error != std::errc{} || end != moves.data() + moves.size())
+        {
+            return std::nullopt;
+        }
+        value.remove_prefix(separator + 1);
+    }
+
+    auto const separator{value.find('+')};
+    std::optional<std::chrono::milliseconds> const base{
+        parse_seconds(value.substr(0, separator))};
+    if (!base || *base <= std::chrono::milliseconds{})
+    {
+        return std::nullopt;
+    }
+    rv.base = *base;
+
+    if (separator != std::string_view::npos)
+    {
+        std::optional<std::chrono::milliseconds> const increment{
+            parse_seconds(value.substr(separator + 1))};
+        if (!increment)
+        {
+            return std::nullopt;
+        }
+        rv.increment = *increment;
+    }
+
+    return rv;
+}
+
+pawn::chess_clock::chess_clock(time_control const& control)
+    : control_{control}
+    , sides_{side_clock{.remaining = control.base,
+                 .moves = 0,
+                 .flagged = false},
+          side_clock{.remaining = control.base, .moves = 0, .flagged = false}}
+{
+}
+
+void pawn::chess_clock::start(piece_color const side,
+    clock_type::time_point const now)
+{
+    assert(running_ == piece_color::none);
+    running_ = side;
+    started_ = now;
+}
+
+bool pawn::chess_clock::stop(clock_type::time_point const now)
+{
+    assert(running_ != piece_color::none);
+
+    side_clock& clock{side(std::exchange(running_, piece_color::none))};
+    clock.remaining -=
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - started_);
+    if (clock.remaining < std::chrono::milliseconds{})
+    {
+        clock.flagged = true;
+        return false;
+    }
+
+    clock.remaining += control_.increment;
+    ++clock.moves;
+    if (control_.moves_per_period != 0 &&
+        clock.moves % control_.moves_per_period == 0)
+    {
+        clock.remaining += control_.base;
+    }
+
+    return true;
+}
+
+std::chrono::milliseconds pawn::chess_clock::remaining(piece_color const side,
+    clock_type::time_point const now) const
+{
+    std::chrono::milliseconds rv{this->side(side).remaining};
+    if (running_ == side)
+    {
+        rv -= std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - started_);
+    }
+    return rv;
+}
+
+pawn::piece_color pawn::chess_clock::running() const { return running_; }
+
+pawn::piece_color pawn::chess_clock::flagged() const
+{
+    for (piece_color const color : {piece_color::white, piece_color::black})
+    {
+        if (side(color).flagged)
+        {
+            return color;
+        }
+    }
+    return piece_color::none;
+}
+
+pawn::search_limits pawn::chess_clock::limits(
+    piece_color const side_to_move) const
+{
+    search_limits rv{.wtime = side(piece_color::white).remaining,
+        .btime = side(piece_color::black).remaining,
+        .winc = control_.increment,
+        .binc = control_.increment};
+
+    if (control_.moves_per_period != 0)
+    {
+        rv.movestogo = control_.moves_per_period -
+            side(side_to_move).moves % control_.moves_per_period;
+    }
+
+    return rv;
+}
+
+pawn::chess_clock::side_clock& pawn::chess_clock::side(piece_color const color)
+{
+    assert(color != piece_color::none);
+    return sides_[std::to_underlying(color) - 1];
+}
+
+pawn::chess_clock::side_clock const& pawn::chess_clock::side(
+    piece_color const color) const
+{
+    assert(color != piece_color::none);
+    return sides_[std::to_underlying(color) - 1];
+}
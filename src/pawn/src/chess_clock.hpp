@@ -0,0 +1,85 @@
+#ifndef PAWN_CHESS_CLOCK_INCLUDED
+#define PAWN_CHESS_CLOCK_INCLUDED
+
+#include <chess.hpp>
+#include <search_limits.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace pawn
+{
+    struct [[nodiscard]] time_control final
+    {
+        std::chrono::milliseconds base{};
+        std::chrono::milliseconds increment{};
+        // Zero for sudden death, otherwise base time is added again after
+        // every moves_per_period moves
+        uint32_t moves_per_period{};
+    };
+
+    // [moves/]base[+increment] with times in seconds, e.g. 10+0.1 or 40/120
+    [[nodiscard]] std::optional<time_control> parse_time_control(
+        std::string_view value);
+
+    class [[nodiscard]] chess_clock final
+    {
+    public:
+        using clock_type = std::chrono::steady_clock;
+
+    public:
+        explicit chess_clock(time_control const& control);
+
+        chess_clock(chess_clock const&) = default;
+
+        chess_clock(chess_clock&&) noexcept = default;
+
+    public:
+        ~chess_clock() = default;
+
+    public:
+        void start(piece_color side,
+            clock_type::time_point now = clock_type::now());
+
+        // Stops the running clock and adds the increment, returns false if the
+        // side ran out of time before moving
+        bool stop(clock_type::time_point now = clock_type::now());
+
+        [[nodiscard]] std::chrono::milliseconds remaining(piece_color side,
+            clock_type::time_point now = clock_type::now()) const;
+
+        [[nodiscard]] piece_color running() const;
+
+        [[nodiscard]] piece_color flagged() const;
+
+        [[nodiscard]] search_limits limits(piece_color side_to_move) const;
+
+    public:
+        chess_clock& operator=(chess_clock const&) = default;
+
+        chess_clock& operator=(chess_clock&&) noexcept = default;
+
+    private:
+        struct [[nodiscard]] side_clock final
+        {
+            std::chrono::milliseconds remaining;
+            uint32_t moves;
+            bool flagged;
+        };
+
+        [[nodiscard]] side_clock& side(piece_color color);
+
+        [[nodiscard]] side_clock const& side(piece_color color) const;
+
+    private:
+        time_control control_;
+        std::array<side_clock, 2> sides_;
+        piece_color running_{piece_color::none};
+        clock_type::time_point started_;
+    };
+} // namespace pawn
+
+#endif
@@ -1,28 +1,34 @@
 #include <chess_game.hpp>
 
+#include <chess.hpp>
+#include <chess_clock.hpp>
+#include <process_telemetry.hpp>
 #include <scene.hpp>
+#include <uci_ast.hpp>
 #include <uci_engine.hpp>
+#include <uci_move.hpp>
 
 #include <cppext_numeric.hpp>
 
 #include <fmt/core.h>
+#include <fmt/format.h>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <iterator>
+#include <mutex>
+#include <optional>
 #include <ranges>
 #include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace
 {
-    [[nodiscard]] constexpr uint8_t to_flat_index(std::string_view string)
-    {
-        return (string[1] - '1') * 8 + (string[0] - 'a');
-    }
-
-    static_assert(to_flat_index("a1") == 0);
-    static_assert(to_flat_index("e2") == 12);
-    static_assert(to_flat_index("h8") == 63);
-
     void set_piece(pawn::board_state& state,
         uint8_t const row,
         uint8_t const column,
@@ -77,11 +83,130 @@ namespace
                     .moved_from_starting_position = false});
         }
     }
+
+    void apply_move(pawn::board_state& board, pawn::uci_move const move)
+    {
+        auto moved_piece{
+            std::exchange(board.tiles[move.from()], pawn::board_piece{})};
+        moved_piece.moved_from_starting_position = true;
+
+        auto& new_tile{board.tiles[move.to()]};
+        if (move.promotion() != pawn::piece_type::none)
+        {
+            moved_piece.type = move.promotion();
+        }
+        else if (moved_piece.type == pawn::piece_type::king)
+        {
+            auto const move_rook = [&board](size_t const from, size_t const to)
+            {
+                board.tiles[to] =
+                    std::exchange(board.tiles[from], pawn::board_piece{});
+                board.tiles[to].moved_from_starting_position = true;
+            };
+
+            size_t const from{move.from()};
+            size_t const to{move.to()};
+            // Squares a1 and a8, castling moves the king two files
+            for (size_t const row : {size_t{0}, size_t{56}})
+            {
+                if (from == row + 4 && to == row + 6)
+                {
+                    move_rook(row + 7, row + 5);
+                }
+                else if (from == row + 4 && to == row + 2)
+                {
+                    move_rook(row, row + 3);
+                }
+            }
+        }
+        new_tile = moved_piece;
+    }
+
+    [[nodiscard]] std::string format_analysis(pawn::search_sample const& sample)
+    {
+        pawn::ast::info const& info{sample.info};
+
+        std::string rv{fmt::format("depth {}/{}  {} {}\nnodes {}  nps {}\n",
+            info.depth,
+            info.seldepth,
+            info.score.mate ? "mate" : "cp",
+            info.score.value,
+            info.nodes,
+            info.nps)};
+        for (uint8_t i{}; i != info.pv_length; ++i)
+        {
+            fmt::format_to(std::back_inserter(rv),
+                "{}{}",
+                i == 0 ? "" : " ",
+                info.pv[i].to_string());
+        }
+        return rv;
+    }
+
+    [[nodiscard]] std::chrono::microseconds cpu_time(
+        pawn::process_usage const& usage)
+    {
+        return usage.user_time + usage.system_time;
+    }
+
+    // CPU utilization is measured since the previous sample of the same
+    // engine process
+    [[nodiscard]] std::string format_usage(pawn::process_usage const& usage,
+        std::optional<pawn::process_usage> const& previous,
+        std::chrono::steady_clock::duration const elapsed)
+    {
+        double utilization{};
+        if (previous && cpu_time(*previous) <= cpu_time(usage) &&
+            elapsed.count() > 0)
+        {
+            utilization = 100.0 *
+                std::chrono::duration<double>(
+                    cpu_time(usage) - cpu_time(*previous)) /
+                elapsed;
+        }
+
+        return fmt::format("cpu {:.1f}s ({:.0f}%)  rss {} MiB  threads {}\n"
+                           "context switches {} voluntary {} involuntary",
+            std::chrono::duration<double>(cpu_time(usage)).count(),
+            utilization,
+            usage.resident_bytes / (1024 * 1024),
+            usage.threads,
+            usage.voluntary_context_switches,
+            usage.involuntary_context_switches);
+    }
+
+    [[nodiscard]] std::string_view color_name(pawn::piece_color const color)
+    {
+        return color == pawn::piece_color::white ? "White" : "Black";
+    }
+
+    [[nodiscard]] bool is_mate_score(pawn::ast::info const& info,
+        bool const winning)
+    {
+        return has_field(info, pawn::ast::info_field::score) &&
+            info.score.mate && (winning == (info.score.value > 0));
+    }
 } // namespace
 
-pawn::chess_game::chess_game(std::string_view engine_command_line)
-    : engine_{engine_command_line}
-    , scene_{engine_}
+pawn::chess_game::chess_game(std::string_view white_engine_command_line,
+    std::string_view black_engine_command_line,
+    time_control const& time_control,
+    option_profile const& profile,
+    uci_reactor& reactor,
+    uci_recorder* const white_recorder,
+    uci_recorder* const black_recorder)
+    : engines_{uci_engine{white_engine_command_line,
+                   reactor,
+                   profile,
+                   {},
+                   white_recorder},
+          uci_engine{black_engine_command_line,
+              reactor,
+              profile,
+              {},
+              black_recorder}}
+    , scene_{engines_[0].log(), engines_[1].log()}
+    , clock_{time_control}
 {
     set_to_starting_position(board_);
 }
@@ -98,69 +223,43 @@ void pawn::chess_game::begin_frame() { scene_.begin_frame(); }
 
 void pawn::chess_game::update()
 {
-    using namespace std::chrono_literals;
-    if (!next_move_.valid())
+    if (awaiting_move_)
     {
-        next_move_ = std::async([this]() { return engine_.next_move(moves_); });
+        if (std::optional<completed_move> const completed{
+                take_completed_move(side_to_move())})
+        {
+            awaiting_move_ = false;
+            complete_move(*completed);
+        }
     }
-    else if (next_move_.wait_for(10ns) == std::future_status::ready)
+    else if (!game_over_)
     {
-        std::string move{next_move_.get()};
-        auto const from{move.substr(0, 2)};
-        auto const to{move.substr(2, 2)};
-        auto moved_piece{
-            std::exchange(board_.tiles[to_flat_index(from)], board_piece{})};
-        moved_piece.moved_from_starting_position = true;
-
-        auto& new_tile{board_.tiles[to_flat_index(to)]};
-        if (move.size() == 5)
+        if (analysis_requested_)
         {
-            switch (move[4])
+            if (!analysing_)
             {
-            case 'r':
-                moved_piece.type = piece_type::rook;
-                break;
-            case 'n':
-                moved_piece.type = piece_type::knight;
-                break;
-            case 'b':
-                moved_piece.type = piece_type::bishop;
-                break;
-            case 'q':
-                moved_piece.type = piece_type::queen;
+                start_analysis();
             }
         }
-        else if (moved_piece.type == piece_type::king)
+        // The clock starts once the engine completes its handshake
+        else if (engine_for(side_to_move()).ready())
         {
-            for (auto row : {1, 8})
+            // The move is searched instead of the position being analysed
+            if (std::exchange(analysing_, false))
             {
-                if (from == fmt::format("e{}", row) &&
-                    to == fmt::format("g{}", row))
-                {
-                    auto const rook_pos{to_flat_index(fmt::format("f{}", row))};
-
-                    board_.tiles[rook_pos] = std::exchange(
-                        board_.tiles[to_flat_index(fmt::format("h{}", row))],
-                        board_piece{});
-                    board_.tiles[rook_pos].moved_from_starting_position = true;
-                }
-                else if (from == fmt::format("e{}", row) &&
-                    to == fmt::format("c{}", row))
-                {
-                    auto const rook_pos{to_flat_index(fmt::format("d{}", row))};
-
-                    board_.tiles[rook_pos] = std::exchange(
-                        board_.tiles[to_flat_index(fmt::format("a{}", row))],
-                        board_piece{});
-                    board_.tiles[rook_pos].moved_from_starting_position = true;
-                }
+                scene_.set_analysis({});
             }
+            request_move();
         }
-        new_tile = moved_piece;
+    }
 
-        moves_.push_back(move);
+    if (analysing_)
+    {
+        update_analysis();
     }
 
+    update_engine_usage();
+
     for (auto const& [index, tile] : std::views::enumerate(board_.tiles))
     {
         if (tile.type == piece_type::none)
@@ -168,8 +267,7 @@ void pawn::chess_game::update()
             continue;
         }
 
-        bool const highlighted{
-            !moves_.empty() && to_flat_index(moves_.back().substr(2)) == index};
+        bool const highlighted{!moves_.empty() && moves_.back().to() == index};
         scene_.add_piece(to_drawable_peice(static_cast<uint8_t>(index / 8),
             index % 8,
             tile.color,
@@ -180,3 +278,186 @@ void pawn::chess_game::update()
 }
 
 void pawn::chess_game::end_frame() { scene_.end_frame(); }
+
+void pawn::chess_game::toggle_analysis()
+{
+    analysis_requested_ = !analysis_requested_;
+}
+
+pawn::uci_engine& pawn::chess_game::engine_for(piece_color const side)
+{
+    return engines_[std::to_underlying(side) - 1];
+}
+
+void pawn::chess_game::request_move()
+{
+    awaiting_move_ = true;
+
+    piece_color const side{side_to_move()};
+    uci_move& expected_move{ponder_moves_[std::to_underlying(side) - 1]};
+
+    clock_.start(side);
+    if (!expected_move.null() && expected_move == moves_.back())
+    {
+        engine_for(side).ponderhit();
+    }
+    else
+    {
+        engine_for(side).next_move(moves_,
+            clock_.limits(side),
+            completion_handler(side));
+    }
+    expected_move = {};
+}
+
+void pawn::chess_game::complete_move(completed_move const& completed)
+{
+    piece_color const side{side_to_move()};
+    std::string_view const loss{side == piece_color::white ? "0-1" : "1-0"};
+
+    if (!clock_.stop(completed.received))
+    {
+        end_game(fmt::format("{} {} lost on time", loss, color_name(side)));
+    }
+    else if (!completed.move)
+    {
+        end_game(fmt::format("{} {} engine failed", loss, color_name(side)));
+    }
+    // Without legal moves the side is either mated, which one of the engines
+    // reports with its score, or stalemated
+    else if (completed.move->null())
+    {
+        if (is_mate_score(completed.info, false) ||
+            is_mate_score(last_info_, true))
+        {
+            end_game(fmt::format("{} {} is checkmated",
+                loss,
+                color_name(side)));
+        }
+        else
+        {
+            end_game("1/2-1/2 Stalemate");
+        }
+    }
+    else
+    {
+        apply_move(board_, *completed.move);
+        moves_.push_back(*completed.move);
+        last_info_ = completed.info;
+        start_pondering(side, completed.ponder);
+    }
+}
+
+void pawn::chess_game::end_game(std::string result)
+{
+    game_over_ = true;
+
+    for (piece_color const side : {piece_color::white, piece_color::black})
+    {
+        uci_move& expected_move{ponder_moves_[std::to_underlying(side) - 1]};
+        if (!expected_move.null())
+        {
+            engine_for(side).stop();
+            expected_move = {};
+        }
+    }
+
+    scene_.set_game_result(std::move(result));
+}
+
+void pawn::chess_game::start_pondering(piece_color const side,
+    uci_move const expected_move)
+{
+    if (expected_move.null())
+    {
+        return;
+    }
+
+    std::vector<uci_move> expected_line{moves_};
+    expected_line.push_back(expected_move);
+    engine_for(side).ponder(expected_line,
+        clock_.limits(side),
+        completion_handler(side));
+
+    ponder_moves_[std::to_underlying(side) - 1] = expected_move;
+}
+
+pawn::search_callback pawn::chess_game::completion_handler(
+    piece_color const side)
+{
+    return [this, side](search_result result)
+    {
+        std::lock_guard const lock{completed_move_mutex_};
+        completed_moves_[std::to_underlying(side) - 1] = {.move = result.move,
+            .ponder = result.ponder,
+            .info = result.info,
+            .received = result.received};
+    };
+}
+
+void pawn::chess_game::start_analysis()
+{
+    analysing_ = true;
+
+    // Pondering would compete with the analysis for the hardware threads,
+    // moves are searched from scratch afterwards
+    for (piece_color const side : {piece_color::white, piece_color::black})
+    {
+        uci_move& expected_move{ponder_moves_[std::to_underlying(side) - 1]};
+        if (!expected_move.null())
+        {
+            engine_for(side).stop();
+            expected_move = {};
+        }
+    }
+
+    engine_for(side_to_move())
+        .next_move(moves_,
+            {.infinite = true},
+            []([[maybe_unused]] search_result const& result) { });
+    scene_.set_analysis("Waiting for the engine");
+}
+
+void pawn::chess_game::update_analysis()
+{
+    if (std::optional<search_sample> const sample{
+            engine_for(side_to_move()).take_latest_info()})
+    {
+        scene_.set_analysis(format_analysis(*sample));
+    }
+}
+
+void pawn::chess_game::update_engine_usage()
+{
+    auto const now{chess_clock::clock_type::now()};
+    auto const elapsed{now - usage_sampled_};
+    if (elapsed < std::chrono::seconds{1})
+    {
+        return;
+    }
+    usage_sampled_ = now;
+
+    for (piece_color const side : {piece_color::white, piece_color::black})
+    {
+        std::optional<process_usage>& previous{
+            engine_usage_[std::to_underlying(side) - 1]};
+
+        std::optional<process_usage> usage{engine_for(side).resource_usage()};
+        scene_.set_engine_usage(side,
+            usage ? format_usage(*usage, previous, elapsed) : std::string{});
+        previous = std::move(usage);
+    }
+}
+
+pawn::piece_color pawn::chess_game::side_to_move() const
+{
+    return moves_.size() % 2 == 0 ? piece_color::white : piece_color::black;
+}
+
+std::optional<pawn::chess_game::completed_move>
+pawn::chess_game::take_completed_move(piece_color const side)
+{
+    std::lock_guard const lock{completed_move_mutex_};
+    return std::exchange(completed_moves_[std::to_underlying(side) - 1],
+        std::nullopt);
+}
@@ -2,11 +2,17 @@
 #define PAWN_CHESS_GAME_INCLUDED
 
 #include <chess.hpp>
+#include <chess_clock.hpp>
+#include <process_telemetry.hpp>
 #include <scene.hpp>
+#include <uci_ast.hpp>
 #include <uci_engine.hpp>
+#include <uci_move.hpp>
+#include <uci_options.hpp>
 
 #include <array>
-#include <future>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -18,6 +24,12 @@ namespace vkrndr
     class vulkan_scene;
 } // namespace vkrndr
 
+namespace pawn
+{
+    class uci_reactor;
+    class uci_recorder;
+} // namespace pawn
+
 namespace pawn
 {
     struct [[nodiscard]] board_piece final
@@ -35,7 +47,15 @@ namespace pawn
     class [[nodiscard]] chess_game final
     {
     public:
-        explicit chess_game(std::string_view engine_command_line);
+        // Each side is played by its own engine process, the command lines
+        // may be the same
+        chess_game(std::string_view white_engine_command_line,
+            std::string_view black_engine_command_line,
+            time_control const& time_control,
+            option_profile const& profile,
+            uci_reactor& reactor,
+            uci_recorder* white_recorder = nullptr,
+            uci_recorder* black_recorder = nullptr);
 
         chess_game(chess_game const&) = delete;
 
@@ -58,18 +78,82 @@ namespace pawn
 
         void end_frame();
 
+        // Between moves the engine of the side to move analyses the position
+        // until analysis is toggled off, the game is paused meanwhile
+        void toggle_analysis();
+
     public:
         chess_game& operator=(chess_game const&) = delete;
 
         chess_game& operator=(chess_game&&) noexcept = delete;
 
     private:
-        uci_engine engine_;
+        // Empty move if the engine failed, the null move if it has no legal
+        // move
+        struct [[nodiscard]] completed_move final
+        {
+            std::optional<uci_move> move;
+            uci_move ponder;
+            ast::info info;
+            chess_clock::clock_type::time_point received;
+        };
+
+        [[nodiscard]] uci_engine& engine_for(piece_color side);
+
+        void request_move();
+
+        // Applies the move or ends the game if the side ran out of time, has
+        // no legal move or lost its engine
+        void complete_move(completed_move const& completed);
+
+        void end_game(std::string result);
+
+        // Lets the engine of the side that just moved search on the reply it
+        // expects
+        void start_pondering(piece_color side, uci_move expected_move);
+
+        // Answers only the turns of the side, a pondering engine can't
+        // complete the move of its opponent
+        [[nodiscard]] search_callback completion_handler(piece_color side);
+
+        void start_analysis();
+
+        // Picks up only the latest update of the engine, however many it
+        // sent since the last frame
+        void update_analysis();
+
+        // Samples the engine processes at most once per second, reading the
+        // counters every frame would cost more than the overlay is worth
+        void update_engine_usage();
+
+        [[nodiscard]] piece_color side_to_move() const;
+
+        [[nodiscard]] std::optional<completed_move> take_completed_move(
+            piece_color side);
+
+    private:
+        std::mutex completed_move_mutex_;
+        // Indexed by the color of the side
+        std::array<std::optional<completed_move>, 2> completed_moves_;
+        bool awaiting_move_{false};
+        bool game_over_{false};
+
+        // Indexed by the color of the side
+        std::array<uci_engine, 2> engines_;
         orthographic_camera camera_;
         scene scene_;
         board_state board_;
-        std::vector<std::string> moves_;
-        std::future<std::string> next_move_;
+        chess_clock clock_;
+        std::vector<uci_move> moves_;
+        // Of the move which was played last, tells a mate of the side to
+        // move which its own engine doesn't report
+        ast::info last_info_{};
+        // The null move while the engine of the side isn't pondering
+        std::array<uci_move, 2> ponder_moves_;
+        bool analysis_requested_{false};
+        bool analysing_{false};
+        chess_clock::clock_type::time_point usage_sampled_;
+        std::array<std::optional<process_usage>, 2> engine_usage_;
     };
 } // namespace pawn
 
@@ -0,0 +1,58 @@
+#include <engine_log.hpp>
+
+#include <algorithm>
+#include <bit>
+
+pawn::engine_log::engine_log(size_t const capacity)
+    : mask_{std::bit_ceil(std::max<size_t>(capacity, 1)) - 1}
+    , slots_(mask_ + 1)
+    , history_(mask_ + 1)
+{
+}
+
+bool pawn::engine_log::push(std::string_view const line)
+{
+    size_t const head{head_.load(std::memory_order_relaxed)};
+    if (head - tail_.load(std::memory_order_acquire) == slots_.size())
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    slot& destination{slots_[head & mask_]};
+    auto const length{std::min(line.size(), max_line_length)};
+    std::copy_n(line.data(), length, destination.text.data());
+    destination.length = static_cast<uint8_t>(length);
+
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+size_t pawn::engine_log::update()
+{
+    size_t tail{tail_.load(std::memory_order_relaxed)};
+    size_t const head{head_.load(std::memory_order_acquire)};
+
+    size_t const count{head - tail};
+    for (; tail != head; ++tail)
+    {
+        if (history_size_ == history_.size())
+        {
+            history_begin_ = (history_begin_ + 1) & mask_;
+            --history_size_;
+        }
+
+        history_[(history_begin_ + history_size_) & mask_] =
+            slots_[tail & mask_];
+        ++history_size_;
+    }
+
+    tail_.store(tail, std::memory_order_release);
+    return count;
+}
+
+std::string_view pawn::engine_log::line(size_t const index) const
+{
+    slot const& source{history_[(history_begin_ + index) & mask_]};
+    return {source.text.data(), source.length};
+}
@@ -0,0 +1,80 @@
+#ifndef PAWN_ENGINE_LOG_INCLUDED
+#define PAWN_ENGINE_LOG_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    // Lock-free channel from a single producer thread to a single consumer
+    // thread. Lines are copied into preallocated slots and truncated to
+    // max_line_length. The consumer keeps a history of the latest lines.
+    class [[nodiscard]] engine_log final
+    {
+    public:
+        static constexpr size_t max_line_length{255};
+
+    public:
+        // Capacity is rounded up to a power of two
+        explicit engine_log(size_t capacity = 256);
+
+        engine_log(engine_log const&) = delete;
+
+        engine_log(engine_log&&) noexcept = delete;
+
+    public:
+        ~engine_log() = default;
+
+    public:
+        // Producer side, returns false and drops the line if the consumer
+        // fell behind by the whole capacity
+        bool push(std::string_view line);
+
+        // Consumer side, moves the pushed lines to the history. Returns the
+        // number of moved lines.
+        size_t update();
+
+        // Consumer side, number of lines in the history
+        [[nodiscard]] size_t size() const { return history_size_; }
+
+        // Consumer side, index zero is the oldest line in the history
+        [[nodiscard]] std::string_view line(size_t index) const;
+
+        [[nodiscard]] uint64_t dropped() const
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+    public:
+        engine_log& operator=(engine_log const&) = delete;
+
+        engine_log& operator=(engine_log&&) noexcept = delete;
+
+    private:
+        struct [[nodiscard]] slot final
+        {
+            std::array<char, max_line_length> text;
+            uint8_t length;
+        };
+
+        static constexpr size_t cache_line_size{64};
+
+    private:
+        size_t mask_;
+        std::vector<slot> slots_;
+
+        alignas(cache_line_size) std::atomic<size_t> head_{};
+        alignas(cache_line_size) std::atomic<size_t> tail_{};
+        alignas(cache_line_size) std::atomic<uint64_t> dropped_{};
+
+        alignas(cache_line_size) std::vector<slot> history_;
+        size_t history_begin_{};
+        size_t history_size_{};
+    };
+} // namespace pawn
+
+#endif
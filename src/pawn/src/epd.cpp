@@ -0,0 +1,99 @@
+#include <epd.hpp>
+
+#include <text_parse.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace
+{
+    [[nodiscard]] std::string_view next_field(std::string_view& value)
+    {
+        value = pawn::trim(value);
+        auto const end{static_cast<size_t>(
+            std::ranges::find_if(value, pawn::is_space) - value.begin())};
+        std::string_view const rv{value.substr(0, end)};
+        value.remove_prefix(end);
+        return rv;
+    }
+
+    [[nodiscard]] bool is_counter(std::string_view const value)
+    {
+        return pawn::parse_number<uint32_t>(value).has_value();
+    }
+
+    [[nodiscard]] std::string_view unquote(std::string_view value)
+    {
+        value = pawn::trim(value);
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+        {
+            value = value.substr(1, value.size() - 2);
+        }
+        return value;
+    }
+} // namespace
+
+std::optional<pawn::epd_position> pawn::parse_epd(std::string_view line)
+{
+    line = trim(line);
+    if (line.empty() || line.starts_with('#'))
+    {
+        return std::nullopt;
+    }
+
+    std::array<std::string_view, 4> fields;
+    for (std::string_view& field : fields)
+    {
+        field = next_field(line);
+    }
+
+    if (fields[3].empty() || std::ranges::count(fields[0], '/') != 7 ||
+        (fields[1] != "w" && fields[1] != "b"))
+    {
+        return std::nullopt;
+    }
+
+    epd_position rv;
+    for (std::string_view const field : fields)
+    {
+        rv.fen.append(field);
+        rv.fen.push_back(' ');
+    }
+
+    std::string_view counters{line};
+    std::string_view const halfmove{next_field(counters)};
+    std::string_view const fullmove{next_field(counters)};
+    if (is_counter(halfmove) && is_counter(fullmove))
+    {
+        rv.fen.append(halfmove);
+        rv.fen.push_back(' ');
+        rv.fen.append(fullmove);
+        line = counters;
+    }
+    else
+    {
+        rv.fen.append("0 1");
+    }
+
+    // Operations are separated by semicolons, e.g. bm Nf3; id "position 1";
+    while (!trim(line).empty())
+    {
+        size_t const end{std::min(line.find(';'), line.size())};
+        std::string_view operation{line.substr(0, end)};
+        line.remove_prefix(std::min(end + 1, line.size()));
+
+        std::string_view const opcode{next_field(operation)};
+        if (opcode == "id")
+        {
+            rv.id = unquote(operation);
+        }
+        else if (opcode == "bm")
+        {
+            rv.best_moves = trim(operation);
+        }
+    }
+
+    return rv;
+}
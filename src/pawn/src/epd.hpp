@@ -0,0 +1,25 @@
+#ifndef PAWN_EPD_INCLUDED
+#define PAWN_EPD_INCLUDED
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace pawn
+{
+    struct [[nodiscard]] epd_position final
+    {
+        // Complete Forsyth-Edwards notation, move counters missing from an
+        // EPD record are set to 0 1
+        std::string fen;
+        // Operands of the id and bm operations, if present
+        std::string id;
+        std::string best_moves;
+    };
+
+    // Accepts EPD records and FEN strings, empty for blank lines, comments
+    // starting with # and lines without the four position fields
+    [[nodiscard]] std::optional<epd_position> parse_epd(std::string_view line);
+} // namespace pawn
+
+#endif
@@ -0,0 +1,66 @@
+#include <latency_histogram.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace
+{
+    [[nodiscard]] size_t bucket_index(
+        pawn::latency_histogram::duration const latency)
+    {
+        auto const microseconds{static_cast<uint64_t>(latency.count())};
+        return std::min<size_t>(std::bit_width(microseconds),
+            pawn::latency_histogram::bucket_count - 1);
+    }
+} // namespace
+
+void pawn::latency_histogram::record(
+    std::chrono::steady_clock::duration const latency)
+{
+    auto const value{std::max(duration{},
+        std::chrono::duration_cast<duration>(latency))};
+
+    ++buckets_[bucket_index(value)];
+    ++count_;
+    total_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+pawn::latency_histogram::duration pawn::latency_histogram::mean() const
+{
+    if (count_ == 0)
+    {
+        return {};
+    }
+
+    return total_ / static_cast<duration::rep>(count_);
+}
+
+pawn::latency_histogram::duration pawn::latency_histogram::percentile(
+    double const percentile) const
+{
+    if (count_ == 0)
+    {
+        return {};
+    }
+
+    auto const rank{std::max<uint64_t>(1,
+        static_cast<uint64_t>(
+            std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 *
+                static_cast<double>(count_))))};
+
+    uint64_t seen{};
+    for (size_t i{}; i != bucket_count; ++i)
+    {
+        seen += buckets_[i];
+        if (seen >= rank)
+        {
+            duration const upper{i == 0 ? 1 : duration::rep{1} << i};
+            return std::clamp(upper, min_, max_);
+        }
+    }
+
+    return max_;
+}
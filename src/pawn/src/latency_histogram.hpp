@@ -0,0 +1,65 @@
+#ifndef PAWN_LATENCY_HISTOGRAM_INCLUDED
+#define PAWN_LATENCY_HISTOGRAM_INCLUDED
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace pawn
+{
+    // Bucket zero holds latencies below one microsecond, bucket i latencies
+    // in [2^(i-1), 2^i) microseconds, the last bucket everything above
+    class [[nodiscard]] latency_histogram final
+    {
+    public:
+        using duration = std::chrono::microseconds;
+
+        static constexpr size_t bucket_count{32};
+
+    public:
+        latency_histogram() = default;
+
+        latency_histogram(latency_histogram const&) = default;
+
+        latency_histogram(latency_histogram&&) noexcept = default;
+
+    public:
+        ~latency_histogram() = default;
+
+    public:
+        void record(std::chrono::steady_clock::duration latency);
+
+        [[nodiscard]] uint64_t count() const { return count_; }
+
+        [[nodiscard]] duration min() const { return min_; }
+
+        [[nodiscard]] duration max() const { return max_; }
+
+        [[nodiscard]] duration mean() const;
+
+        // Upper bound of the bucket containing the percentile, clamped to the
+        // largest recorded latency
+        [[nodiscard]] duration percentile(double percentile) const;
+
+        [[nodiscard]] std::span<uint64_t const, bucket_count> buckets() const
+        {
+            return buckets_;
+        }
+
+    public:
+        latency_histogram& operator=(latency_histogram const&) = default;
+
+        latency_histogram& operator=(latency_histogram&&) noexcept = default;
+
+    private:
+        std::array<uint64_t, bucket_count> buckets_{};
+        uint64_t count_{};
+        duration total_{};
+        duration min_{duration::max()};
+        duration max_{};
+    };
+} // namespace pawn
+
+#endif
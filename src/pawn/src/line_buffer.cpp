@@ -0,0 +1,65 @@
+#include <line_buffer.hpp>
+
+#include <text_parse.hpp>
+#include <text_scan.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+pawn::line_buffer::line_buffer(size_t const capacity)
+    : buffer_(std::max<size_t>(capacity, 1))
+{
+}
+
+std::span<char> pawn::line_buffer::prepare()
+{
+    if (begin_ != 0)
+    {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        scanned_ -= begin_;
+        begin_ = 0;
+    }
+
+    if (end_ == buffer_.size())
+    {
+        buffer_.resize(buffer_.size() * 2);
+    }
+
+    return {buffer_.data() + end_, buffer_.size() - end_};
+}
+
+void pawn::line_buffer::commit(size_t const bytes)
+{
+    assert(end_ + bytes <= buffer_.size());
+    end_ += bytes;
+}
+
+std::optional<std::string_view> pawn::line_buffer::next_line()
+{
+    char const* const last{buffer_.data() + end_};
+    char const* const terminator{
+        find_newline(buffer_.data() + scanned_, last)};
+    if (terminator == last)
+    {
+        scanned_ = end_;
+        return std::nullopt;
+    }
+
+    auto const length{
+        static_cast<size_t>(terminator - buffer_.data()) - begin_};
+    std::string_view const line{buffer_.data() + begin_, length};
+
+    begin_ += length + 1;
+    scanned_ = begin_;
+
+    return trim(line);
+}
+
+void pawn::line_buffer::clear()
+{
+    begin_ = 0;
+    end_ = 0;
+    scanned_ = 0;
+}
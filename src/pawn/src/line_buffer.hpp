@@ -0,0 +1,52 @@
+#ifndef PAWN_LINE_BUFFER_INCLUDED
+#define PAWN_LINE_BUFFER_INCLUDED
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    // Splits data read in bulk into lines which are handed out as views into
+    // the buffer, the buffer grows only for lines longer than its capacity
+    class [[nodiscard]] line_buffer final
+    {
+    public:
+        explicit line_buffer(size_t capacity = 64 * 1024);
+
+        line_buffer(line_buffer const&) = default;
+
+        line_buffer(line_buffer&&) noexcept = default;
+
+    public:
+        ~line_buffer() = default;
+
+    public:
+        // Space for the next read, invalidates the lines returned so far
+        [[nodiscard]] std::span<char> prepare();
+
+        void commit(size_t bytes);
+
+        // Next complete line without the line terminator and surrounding
+        // whitespace
+        [[nodiscard]] std::optional<std::string_view> next_line();
+
+        void clear();
+
+    public:
+        line_buffer& operator=(line_buffer const&) = default;
+
+        line_buffer& operator=(line_buffer&&) noexcept = default;
+
+    private:
+        std::vector<char> buffer_;
+        size_t begin_{};
+        size_t end_{};
+        // Data before this position is known not to contain a line terminator
+        size_t scanned_{};
+    };
+} // namespace pawn
+
+#endif
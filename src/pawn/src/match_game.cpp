@@ -0,0 +1,209 @@
+#include <match_game.hpp>
+
+#include <chess.hpp>
+#include <chess_clock.hpp>
+#include <uci_ast.hpp>
+#include <uci_engine.hpp>
+#include <uci_move.hpp>
+#include <uci_session.hpp>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace asio = boost::asio;
+
+namespace
+{
+    constexpr int32_t mate_score{100000};
+
+    [[nodiscard]] pawn::game_outcome loss_of(pawn::piece_color const side)
+    {
+        return side == pawn::piece_color::white
+            ? pawn::game_outcome::black_wins
+            : pawn::game_outcome::white_wins;
+    }
+
+    // Score of the last principal variation, from the point of view of the
+    // side which searched
+    [[nodiscard]] std::optional<int32_t> reported_score(
+        pawn::ast::info const& info)
+    {
+        if (!has_field(info, pawn::ast::info_field::score))
+        {
+            return std::nullopt;
+        }
+
+        if (!info.score.mate)
+        {
+            return info.score.value;
+        }
+
+        return info.score.value > 0 ? mate_score : -mate_score;
+    }
+
+    [[nodiscard]] bool is_mate_score(pawn::ast::info const& info,
+        bool const winning)
+    {
+        return has_field(info, pawn::ast::info_field::score) &&
+            info.score.mate && (winning == (info.score.value > 0));
+    }
+
+    // Counts consecutive plies which satisfy an adjudication rule
+    class [[nodiscard]] streak final
+    {
+    public:
+        [[nodiscard]] uint32_t update(bool const satisfied)
+        {
+            length_ = satisfied ? length_ + 1 : 0;
+            return length_;
+        }
+
+    private:
+        uint32_t length_{};
+    };
+} // namespace
+
+std::string_view pawn::to_string_view(game_termination const termination)
+{
+    switch (termination)
+    {
+    case game_termination::checkmate:
+        return "checkmate";
+    case game_termination::stalemate:
+        return "stalemate";
+    case game_termination::time_forfeit:
+        return "time forfeit";
+    case game_termination::engine_failure:
+        return "engine failure";
+    case game_termination::move_limit:
+        return "move limit";
+    case game_termination::draw_adjudication:
+        return "draw adjudication";
+    case game_termination::resign_adjudication:
+        return "resign adjudication";
+    }
+    return {};
+}
+
+pawn::game_record pawn::play_game(uci_engine& white,
+    uci_engine& black,
+    std::span<uci_move const> const opening,
+    time_control const& time_control,
+    adjudication const& adjudication)
+{
+    asio::io_context context{1};
+    uci_session white_session{white};
+    uci_session black_session{black};
+
+    auto game{asio::co_spawn(context,
+        play_game(white_session,
+            black_session,
+            {opening.begin(), opening.end()},
+            time_control,
+            adjudication),
+        asio::use_future)};
+    context.run();
+    return game.get();
+}
+
+asio::awaitable<pawn::game_record> pawn::play_game(uci_session& white,
+    uci_session& black,
+    std::vector<uci_move> opening,
+    time_control const time_control,
+    adjudication const adjudication)
+{
+    game_record rv{.moves = std::move(opening)};
+
+    chess_clock clock{time_control};
+    streak draw_streak;
+    // Positive while white is winning
+    streak white_streak;
+    streak black_streak;
+    ast::info opponent_info{};
+
+    while (adjudication.max_plies == 0 ||
+        rv.moves.size() < adjudication.max_plies)
+    {
+        piece_color const side{rv.moves.size() % 2 == 0 ? piece_color::white
+                                                        : piece_color::black};
+        uci_session& session{side == piece_color::white ? white : black};
+
+        clock.start(side);
+        search_result const result{
+            co_await session.go(rv.moves, clock.limits(side))};
+
+        if (!clock.stop(result.received))
+        {
+            rv.outcome = loss_of(side);
+            rv.termination = game_termination::time_forfeit;
+            co_return rv;
+        }
+
+        if (!result.move)
+        {
+            rv.outcome = loss_of(side);
+            rv.termination = game_termination::engine_failure;
+            co_return rv;
+        }
+
+        // Without legal moves the side is either mated, which one of the
+        // engines reports with its score, or stalemated
+        if (result.move->null())
+        {
+            if (is_mate_score(result.info, false) ||
+                is_mate_score(opponent_info, true))
+            {
+                rv.outcome = loss_of(side);
+                rv.termination = game_termination::checkmate;
+            }
+            else
+            {
+                rv.outcome = game_outcome::draw;
+                rv.termination = game_termination::stalemate;
+            }
+            co_return rv;
+        }
+        rv.moves.push_back(*result.move);
+
+        std::optional<int32_t> const score{reported_score(result.info)};
+        std::optional<int32_t> const white_score{
+            score && side == piece_color::black ? std::optional{-*score}
+                                                : score};
+
+        uint32_t const draws{draw_streak.update(
+            score && std::abs(*score) <= adjudication.draw_score)};
+        if (adjudication.draw_plies != 0 &&
+            rv.moves.size() > adjudication.draw_after_plies &&
+            draws >= adjudication.draw_plies)
+        {
+            rv.outcome = game_outcome::draw;
+            rv.termination = game_termination::draw_adjudication;
+            co_return rv;
+        }
+
+        uint32_t const white_winning{white_streak.update(
+            white_score && *white_score >= adjudication.resign_score)};
+        uint32_t const black_winning{black_streak.update(
+            white_score && *white_score <= -adjudication.resign_score)};
+        if (adjudication.resign_plies != 0 &&
+            std::max(white_winning, black_winning) >= adjudication.resign_plies)
+        {
+            rv.outcome = white_winning != 0 ? game_outcome::white_wins
+                                            : game_outcome::black_wins;
+            rv.termination = game_termination::resign_adjudication;
+            co_return rv;
+        }
+
+        opponent_info = result.info;
+    }
+
+    co_return rv;
+}
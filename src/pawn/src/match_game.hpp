@@ -0,0 +1,88 @@
+#ifndef PAWN_MATCH_GAME_INCLUDED
+#define PAWN_MATCH_GAME_INCLUDED
+
+#include <chess_clock.hpp>
+#include <uci_move.hpp>
+
+#include <boost/asio/awaitable.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    class uci_engine;
+    class uci_session;
+} // namespace pawn
+
+namespace pawn
+{
+    enum class game_outcome : uint8_t
+    {
+        white_wins,
+        black_wins,
+        draw
+    };
+
+    enum class game_termination : uint8_t
+    {
+        checkmate,
+        stalemate,
+        time_forfeit,
+        // The engine exited or stalled after the last restart
+        engine_failure,
+        move_limit,
+        draw_adjudication,
+        resign_adjudication
+    };
+
+    [[nodiscard]] std::string_view to_string_view(game_termination termination);
+
+    // Scores are in centipawns from the point of view of the side to move,
+    // mate scores count as beyond any threshold. Zero plies disable an
+    // adjudication.
+    struct [[nodiscard]] adjudication final
+    {
+        uint32_t max_plies{400};
+
+        // Drawn once both engines report a score within draw_score for
+        // draw_plies consecutive plies after draw_after_plies
+        int32_t draw_score{10};
+        uint32_t draw_plies{8};
+        uint32_t draw_after_plies{80};
+
+        // Lost once both engines agree on a score beyond resign_score for
+        // resign_plies consecutive plies
+        int32_t resign_score{1000};
+        uint32_t resign_plies{6};
+    };
+
+    struct [[nodiscard]] game_record final
+    {
+        game_outcome outcome{game_outcome::draw};
+        game_termination termination{game_termination::move_limit};
+        std::vector<uci_move> moves;
+    };
+
+    // Plays a game from the position after the opening moves, the engines
+    // must not be searching. Runs on the calling thread until the game ends.
+    [[nodiscard]] game_record play_game(uci_engine& white,
+        uci_engine& black,
+        std::span<uci_move const> opening,
+        time_control const& time_control,
+        adjudication const& adjudication);
+
+    // Plays the game as a coroutine, the sessions must outlive it. Time is
+    // charged until the engine's move is read, not until the coroutine is
+    // resumed, so games can share a busy thread.
+    [[nodiscard]] boost::asio::awaitable<game_record> play_game(
+        uci_session& white,
+        uci_session& black,
+        std::vector<uci_move> opening,
+        time_control time_control,
+        adjudication adjudication);
+} // namespace pawn
+
+#endif
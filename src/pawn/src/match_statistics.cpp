@@ -0,0 +1,101 @@
+#include <match_statistics.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr double confidence_95{1.959964};
+
+    [[nodiscard]] double expected_score(double const elo)
+    {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+
+    [[nodiscard]] double elo_difference(double const score)
+    {
+        return -400.0 * std::log10(1.0 / score - 1.0);
+    }
+
+    struct [[nodiscard]] score_moments final
+    {
+        double mean;
+        // Variance of a single game score
+        double variance;
+    };
+
+    [[nodiscard]] score_moments moments(pawn::match_score const& score)
+    {
+        auto const count{static_cast<double>(games(score))};
+        auto const wins{static_cast<double>(score.wins) / count};
+        auto const draws{static_cast<double>(score.draws) / count};
+        auto const losses{static_cast<double>(score.losses) / count};
+
+        double const mean{wins + draws / 2.0};
+        double const variance{wins * (1.0 - mean) * (1.0 - mean) +
+            draws * (0.5 - mean) * (0.5 - mean) + losses * mean * mean};
+        return {mean, variance};
+    }
+} // namespace
+
+std::optional<pawn::elo_estimate> pawn::estimate_elo(match_score const& score)
+{
+    uint32_t const count{games(score)};
+    if (count == 0 || score.wins == count || score.draws == count ||
+        score.losses == count)
+    {
+        return std::nullopt;
+    }
+
+    auto const [mean, variance]{moments(score)};
+    double const deviation{
+        confidence_95 * std::sqrt(variance / static_cast<double>(count))};
+
+    double const lower{mean - deviation};
+    double const upper{mean + deviation};
+    double const margin{lower <= 0.0 || upper >= 1.0
+            ? std::numeric_limits<double>::infinity()
+            : (elo_difference(upper) - elo_difference(lower)) / 2.0};
+
+    return elo_estimate{.elo = elo_difference(mean), .margin = margin};
+}
+
+pawn::sprt_status pawn::sprt(match_score const& score,
+    sprt_parameters const& parameters)
+{
+    sprt_status rv{
+        .llr = 0.0,
+        .lower_bound =
+            std::log(parameters.beta / (1.0 - parameters.alpha)),
+        .upper_bound =
+            std::log((1.0 - parameters.beta) / parameters.alpha),
+        .state = sprt_state::running};
+
+    uint32_t const count{games(score)};
+    if (count == 0)
+    {
+        return rv;
+    }
+
+    auto const [mean, variance]{moments(score)};
+    if (variance == 0.0)
+    {
+        return rv;
+    }
+
+    double const score0{expected_score(parameters.elo0)};
+    double const score1{expected_score(parameters.elo1)};
+    rv.llr = static_cast<double>(count) * (score1 - score0) *
+        (2.0 * mean - score0 - score1) / (2.0 * variance);
+
+    if (rv.llr >= rv.upper_bound)
+    {
+        rv.state = sprt_state::accepted_h1;
+    }
+    else if (rv.llr <= rv.lower_bound)
+    {
+        rv.state = sprt_state::accepted_h0;
+    }
+
+    return rv;
+}
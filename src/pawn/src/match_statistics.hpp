@@ -0,0 +1,64 @@
+#ifndef PAWN_MATCH_STATISTICS_INCLUDED
+#define PAWN_MATCH_STATISTICS_INCLUDED
+
+#include <cstdint>
+#include <optional>
+
+namespace pawn
+{
+    // Results from the point of view of the first engine of a pairing
+    struct [[nodiscard]] match_score final
+    {
+        uint32_t wins{};
+        uint32_t draws{};
+        uint32_t losses{};
+    };
+
+    [[nodiscard]] constexpr uint32_t games(match_score const& score)
+    {
+        return score.wins + score.draws + score.losses;
+    }
+
+    struct [[nodiscard]] elo_estimate final
+    {
+        double elo{};
+        // Half width of the 95% confidence interval, infinite while the
+        // interval reaches a score of zero or one
+        double margin{};
+    };
+
+    // Empty while all games have the same result
+    [[nodiscard]] std::optional<elo_estimate> estimate_elo(
+        match_score const& score);
+
+    // Tests H0: elo <= elo0 against H1: elo >= elo1
+    struct [[nodiscard]] sprt_parameters final
+    {
+        double elo0{0.0};
+        double elo1{5.0};
+        double alpha{0.05};
+        double beta{0.05};
+    };
+
+    enum class sprt_state : uint8_t
+    {
+        running,
+        accepted_h0,
+        accepted_h1
+    };
+
+    struct [[nodiscard]] sprt_status final
+    {
+        double llr{};
+        double lower_bound{};
+        double upper_bound{};
+        sprt_state state{sprt_state::running};
+    };
+
+    // Log-likelihood ratio of the generalized SPRT with the normal
+    // approximation of the game score
+    [[nodiscard]] sprt_status sprt(match_score const& score,
+        sprt_parameters const& parameters);
+} // namespace pawn
+
+#endif
@@ -1,4 +1,8 @@
+#include <chess_clock.hpp>
 #include <chess_game.hpp>
+#include <uci_options.hpp>
+#include <uci_reactor.hpp>
+#include <uci_recording.hpp>
 
 #include <sdl_window.hpp>
 #include <vulkan_context.hpp>
@@ -10,11 +14,21 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_events.h>
+#include <SDL2/SDL_scancode.h>
 #include <SDL2/SDL_video.h>
 
 #include <vulkan/vulkan_core.h>
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <thread>
 
 // IWYU pragma: no_include <fmt/core.h>
 // IWYU pragma: no_include <spdlog/common.h>
@@ -27,6 +41,43 @@ namespace
     constexpr bool enable_validation_layers{true};
 #endif
 
+    constexpr pawn::time_control default_time_control{
+        .base = std::chrono::minutes{1},
+        .increment = std::chrono::seconds{1}};
+
+    // Leaves a hardware thread for rendering, the move overhead covers the
+    // latency of the pipes and the frame in which the move is received
+    [[nodiscard]] pawn::option_profile default_profile()
+    {
+        return {.threads =
+                    std::max(std::thread::hardware_concurrency(), 2U) - 1,
+            .hash = 256,
+            .move_overhead = std::chrono::milliseconds{50}};
+    }
+
+    // Time controls start with a number, e.g. 60+1 or .5, engine command
+    // lines don't. A mistyped time control isn't taken for an engine.
+    [[nodiscard]] bool is_time_control_shaped(std::string_view const value)
+    {
+        auto const is_digit{[](char const c) { return c >= '0' && c <= '9'; }};
+        return !value.empty() &&
+            (is_digit(value.front()) ||
+                (value.size() > 1 && value[0] == '.' && is_digit(value[1])));
+    }
+
+    // session.ucilog is recorded to session.white.ucilog and
+    // session.black.ucilog
+    [[nodiscard]] std::filesystem::path side_recording(
+        std::filesystem::path const& path,
+        std::string_view const side)
+    {
+        std::filesystem::path filename{path.stem()};
+        filename += ".";
+        filename += side;
+        filename += path.extension();
+        return path.parent_path() / filename;
+    }
+
     [[nodiscard]] bool is_quit_event(SDL_Event const& event,
         SDL_Window* const window)
     {
@@ -44,10 +95,60 @@ namespace
             return false;
         }
     }
+
+    [[nodiscard]] bool is_analysis_toggle_event(SDL_Event const& event)
+    {
+        return event.type == SDL_KEYDOWN && event.key.repeat == 0 &&
+            event.key.keysym.scancode == SDL_SCANCODE_SPACE;
+    }
 } // namespace
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
+// pawn <engine> [<black engine>] [<time control>] [<recording>]
+int main(int argc, char** argv)
 {
+    if (argc < 2)
+    {
+        fmt::print(stderr,
+            "usage: pawn <engine> [<black engine>] [<time control>] "
+            "[<recording>]\n");
+        return EXIT_FAILURE;
+    }
+
+    // Without a black engine the same engine plays both sides, in separate
+    // processes
+    int argument{2};
+    std::string_view const white_engine{argv[1]};
+    std::string_view black_engine{white_engine};
+    if (argc > argument && !is_time_control_shaped(argv[argument]))
+    {
+        black_engine = argv[argument++];
+    }
+
+    std::optional<pawn::time_control> time_control{default_time_control};
+    if (argc > argument)
+    {
+        time_control = pawn::parse_time_control(argv[argument]);
+        if (!time_control)
+        {
+            fmt::print(stderr,
+                "invalid time control {}, expected [moves/]base[+increment] "
+                "in seconds\n",
+                argv[argument]);
+            return EXIT_FAILURE;
+        }
+        ++argument;
+    }
+
+    // Engine traffic is recorded for replay with uci_replay
+    std::optional<pawn::uci_recorder> white_recorder;
+    std::optional<pawn::uci_recorder> black_recorder;
+    if (argc > argument)
+    {
+        std::filesystem::path const recording{argv[argument]};
+        white_recorder.emplace(side_recording(recording, "white"));
+        black_recorder.emplace(side_recording(recording, "black"));
+    }
+
     vkrndr::sdl_guard const sdl_guard{SDL_INIT_VIDEO};
 
     vkrndr::sdl_window window{"pawn",
@@ -57,7 +158,14 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
         512,
         512};
 
-    pawn::chess_game game{argv[1]};
+    pawn::uci_reactor reactor;
+    pawn::chess_game game{white_engine,
+        black_engine,
+        *time_control,
+        default_profile(),
+        reactor,
+        white_recorder ? &*white_recorder : nullptr,
+        black_recorder ? &*black_recorder : nullptr};
 
     auto context{vkrndr::create_context(&window, enable_validation_layers)};
     auto device{vkrndr::create_device(context)};
@@ -67,7 +175,9 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
             &context,
             &device,
             &swap_chain};
-        renderer.set_imgui_layer(enable_validation_layers);
+        // The analysis and the result of the game are shown in ImGui
+        // windows, also in release builds
+        renderer.set_imgui_layer(true);
 
         game.attach_renderer(&device, &renderer);
 
@@ -77,15 +187,16 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
             SDL_Event event;
             while (SDL_PollEvent(&event) != 0)
             {
-                if (enable_validation_layers)
-                {
-                    ImGui_ImplSDL2_ProcessEvent(&event);
-                }
+                ImGui_ImplSDL2_ProcessEvent(&event);
 
                 if (is_quit_event(event, window.native_handle()))
                 {
                     done = true;
                 }
+                else if (is_analysis_toggle_event(event))
+                {
+                    game.toggle_analysis();
+                }
             }
 
             renderer.begin_frame();
@@ -0,0 +1,361 @@
+#include <analysis_cache.hpp>
+#include <epd.hpp>
+#include <search_limits.hpp>
+#include <text_parse.hpp>
+#include <uci_ast.hpp>
+#include <uci_engine.hpp>
+#include <uci_engine_pool.hpp>
+#include <uci_move.hpp>
+#include <uci_reactor.hpp>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <latch>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// pawn_analyse --engine <command line> --positions <file> [--depth <n>]
+//     [--nodes <n>] [--movetime <ms>] [--engines <n>] [--threads <n>]
+//     [--hash <MiB>] [--cache <file>]
+//
+// Positions are read from an EPD or FEN file, each is analysed by the first
+// idle engine. Results are written as JSON lines in the order in which the
+// analyses complete, the line number identifies the position. With a cache
+// file depth limited analyses of earlier runs are reused.
+
+namespace
+{
+    struct [[nodiscard]] analysis_options final
+    {
+        std::string engine;
+        std::string positions;
+        std::string cache;
+        pawn::search_limits limits;
+        pawn::uci_engine_pool_options pool;
+    };
+
+    struct [[nodiscard]] position_entry final
+    {
+        size_t line;
+        pawn::epd_position position;
+    };
+
+    [[nodiscard]] std::optional<analysis_options> parse_options(int const argc,
+        char** const argv)
+    {
+        // Every option takes a value
+        if (argc > 1 && argc % 2 == 0)
+        {
+            fmt::print(stderr, "{} is missing its value\n", argv[argc - 1]);
+            return std::nullopt;
+        }
+
+        analysis_options rv;
+        for (int i{1}; i + 1 < argc; i += 2)
+        {
+            std::string_view const name{argv[i]};
+            std::string_view const value{argv[i + 1]};
+            if (name == "--engine")
+            {
+                rv.engine = value;
+            }
+            else if (name == "--positions")
+            {
+                rv.positions = value;
+            }
+            else if (name == "--depth")
+            {
+                rv.limits.depth = pawn::parse_number<uint32_t>(value);
+                if (!rv.limits.depth)
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (name == "--nodes")
+            {
+                rv.limits.nodes = pawn::parse_number<uint64_t>(value);
+                if (!rv.limits.nodes)
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (name == "--movetime")
+            {
+                auto const movetime{pawn::parse_number<uint32_t>(value)};
+                if (!movetime)
+                {
+                    return std::nullopt;
+                }
+                rv.limits.movetime = std::chrono::milliseconds{*movetime};
+            }
+            else if (name == "--engines")
+            {
+                auto const engines{pawn::parse_number<size_t>(value)};
+                if (!engines)
+                {
+                    return std::nullopt;
+                }
+                rv.pool.engines = *engines;
+            }
+            else if (name == "--threads")
+            {
+                rv.pool.profile.threads = pawn::parse_number<uint32_t>(value);
+                if (!rv.pool.profile.threads)
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (name == "--hash")
+            {
+                rv.pool.profile.hash = pawn::parse_number<uint32_t>(value);
+                if (!rv.pool.profile.hash)
+                {
+                    return std::nullopt;
+                }
+            }
+            else if (name == "--cache")
+            {
+                rv.cache = value;
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        if (rv.engine.empty() || rv.positions.empty())
+        {
+            return std::nullopt;
+        }
+
+        if (!rv.limits.depth && !rv.limits.nodes && !rv.limits.movetime)
+        {
+            rv.limits.depth = 20;
+        }
+
+        return rv;
+    }
+
+    [[nodiscard]] std::optional<std::vector<position_entry>> read_positions(
+        std::string const& path)
+    {
+        std::ifstream stream{path};
+        if (!stream)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<position_entry> rv;
+        std::string line;
+        for (size_t number{1}; std::getline(stream, line); ++number)
+        {
+            if (std::optional<pawn::epd_position> position{
+                    pawn::parse_epd(line)})
+            {
+                rv.push_back(
+                    {.line = number, .position = std::move(*position)});
+            }
+        }
+        return rv;
+    }
+
+    void append_json_string(std::string& json, std::string_view const value)
+    {
+        json.push_back('"');
+        for (char const c : value)
+        {
+            switch (c)
+            {
+            case '"':
+                json.append("\\\"");
+                break;
+            case '\\':
+                json.append("\\\\");
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    fmt::format_to(std::back_inserter(json),
+                        "\\u{:04x}",
+                        static_cast<unsigned>(c));
+                }
+                else
+                {
+                    json.push_back(c);
+                }
+            }
+        }
+        json.push_back('"');
+    }
+
+    void append_json_field(std::string& json,
+        std::string_view const name,
+        std::string_view const value)
+    {
+        fmt::format_to(std::back_inserter(json), ",\"{}\":", name);
+        append_json_string(json, value);
+    }
+
+    // Notation never needs escaping
+    void append_json_move(std::string& json, pawn::uci_move const move)
+    {
+        std::array<char, pawn::uci_move::max_length> notation; // NOLINT
+        json.push_back('"');
+        json.append(notation.data(), move.to_chars(notation.data()));
+        json.push_back('"');
+    }
+
+    [[nodiscard]] std::string to_json(position_entry const& entry,
+        pawn::search_result const& result)
+    {
+        using pawn::ast::info_field;
+
+        std::string rv{fmt::format("{{\"line\":{}", entry.line)};
+        if (!entry.position.id.empty())
+        {
+            append_json_field(rv, "id", entry.position.id);
+        }
+        append_json_field(rv, "fen", entry.position.fen);
+        if (!entry.position.best_moves.empty())
+        {
+            append_json_field(rv, "bm", entry.position.best_moves);
+        }
+
+        if (!result.move)
+        {
+            append_json_field(rv, "error", "engine failure");
+            rv.push_back('}');
+            return rv;
+        }
+
+        rv.append(",\"bestmove\":");
+        append_json_move(rv, *result.move);
+        if (!result.ponder.null())
+        {
+            rv.append(",\"ponder\":");
+            append_json_move(rv, result.ponder);
+        }
+
+        pawn::ast::info const& info{result.info};
+        auto out{std::back_inserter(rv)};
+        if (has_field(info, info_field::score))
+        {
+            fmt::format_to(out,
+                ",\"score\":{{\"{}\":{}}}",
+                info.score.mate ? "mate" : "cp",
+                info.score.value);
+        }
+        if (has_field(info, info_field::depth))
+        {
+            fmt::format_to(out, ",\"depth\":{}", info.depth);
+        }
+        if (has_field(info, info_field::seldepth))
+        {
+            fmt::format_to(out, ",\"seldepth\":{}", info.seldepth);
+        }
+        if (has_field(info, info_field::nodes))
+        {
+            fmt::format_to(out, ",\"nodes\":{}", info.nodes);
+        }
+        if (has_field(info, info_field::nps))
+        {
+            fmt::format_to(out, ",\"nps\":{}", info.nps);
+        }
+        if (has_field(info, info_field::time))
+        {
+            fmt::format_to(out, ",\"time\":{}", info.time);
+        }
+        if (has_field(info, info_field::pv))
+        {
+            rv.append(",\"pv\":[");
+            for (uint8_t i{}; i != info.pv_length; ++i)
+            {
+                if (i != 0)
+                {
+                    rv.push_back(',');
+                }
+                append_json_move(rv, info.pv[i]);
+            }
+            rv.push_back(']');
+        }
+
+        rv.push_back('}');
+        return rv;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::optional<analysis_options> const options{parse_options(argc, argv)};
+    if (!options)
+    {
+        fmt::print(stderr,
+            "usage: pawn_analyse --engine <command line> --positions <file> "
+            "[--depth <n>] [--nodes <n>] [--movetime <ms>] [--engines <n>] "
+            "[--threads <n>] [--hash <MiB>] [--cache <file>]\n");
+        return EXIT_FAILURE;
+    }
+
+    std::optional<std::vector<position_entry>> const positions{
+        read_positions(options->positions)};
+    if (!positions)
+    {
+        fmt::print(stderr, "Unable to read {}\n", options->positions);
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<pawn::analysis_cache> cache;
+    if (!options->cache.empty())
+    {
+        try
+        {
+            cache = std::make_unique<pawn::analysis_cache>(options->cache);
+        }
+        catch (std::exception const& e)
+        {
+            fmt::print(stderr,
+                "Unable to open cache {}: {}\n",
+                options->cache,
+                e.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    pawn::uci_engine_pool_options pool_options{options->pool};
+    pool_options.cache = cache.get();
+
+    pawn::uci_reactor reactor;
+    pawn::uci_engine_pool pool{options->engine, reactor, pool_options};
+
+    // Results are written on the reactor thread, one at a time
+    std::latch remaining{static_cast<std::ptrdiff_t>(positions->size())};
+    for (position_entry const& entry : *positions)
+    {
+        pool.analyse(entry.position.fen,
+            options->limits,
+            [&entry, &remaining](pawn::search_result const& result)
+            {
+                std::string const line{to_json(entry, result)};
+                std::fwrite(line.data(), 1, line.size(), stdout);
+                std::fputc('\n', stdout);
+                std::fflush(stdout);
+                remaining.count_down();
+            });
+    }
+    remaining.wait();
+
+    return EXIT_SUCCESS;
+}
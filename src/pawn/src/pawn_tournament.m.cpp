@@ -0,0 +1,682 @@
+#include <chess_clock.hpp>
+#include <match_game.hpp>
+#include <match_statistics.hpp>
+#include <process_telemetry.hpp>
+#include <text_parse.hpp>
+#include <uci_engine.hpp>
+#include <uci_engine_standby.hpp>
+#include <uci_move.hpp>
+#include <uci_options.hpp>
+#include <uci_reactor.hpp>
+#include <uci_session.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// pawn_tournament --engine <command line> --engine <command line> [...]
+//     [--gauntlet] [--openings <file>] [--rounds <n>] [--concurrency <n>]
+//     [--tc <time control>] [--sprt <elo0> <elo1>] [--standby <n>]
+//     [--cpus <list> | --numa <node>] [--metrics <file>]
+//
+// Every pairing plays each opening twice with colors reversed, once per
+// round. Openings are lines of moves from the starting position in long
+// algebraic notation. Each of the concurrent games is played by a worker
+// coroutine, engine processes are reused between the games of a worker and
+// standby engines are started ahead of the games which need them.
+// With a CPU list the engines of each worker are pinned to one of the CPUs.
+// Metrics are CSV rows with the resources used by each engine in a game.
+
+namespace asio = boost::asio;
+
+namespace
+{
+    constexpr pawn::time_control default_time_control{
+        .base = std::chrono::seconds{10},
+        .increment = std::chrono::milliseconds{100}};
+
+    // Engines of parallel games shouldn't compete for cores
+    constexpr pawn::option_profile engine_profile{.threads = 1, .hash = 16};
+
+    // Games only wait for their engines, a few threads drive all of them
+    constexpr uint32_t game_threads{2};
+
+    struct [[nodiscard]] tournament_options final
+    {
+        std::vector<std::string> engines;
+        // The first engine plays against all others, otherwise everyone
+        // plays against everyone
+        bool gauntlet{false};
+        std::optional<std::filesystem::path> openings;
+        uint32_t rounds{1};
+        uint32_t standby{};
+        std::vector<uint32_t> cpus;
+        std::optional<std::filesystem::path> metrics;
+        uint32_t concurrency{std::max(std::thread::hardware_concurrency(), 1U)};
+        pawn::time_control time_control{default_time_control};
+        std::optional<pawn::sprt_parameters> sprt;
+        pawn::adjudication adjudication;
+    };
+
+    [[nodiscard]] std::optional<tournament_options> parse_options(
+        int const argc,
+        char** const argv)
+    {
+        tournament_options rv;
+        for (int i{1}; i != argc; ++i)
+        {
+            std::string_view const name{argv[i]};
+            auto const value{[&i, argc, argv]()
+                {
+                    std::optional<std::string_view> argument;
+                    if (i + 1 < argc)
+                    {
+                        argument = argv[++i];
+                    }
+                    return argument;
+                }};
+
+            if (name == "--gauntlet")
+            {
+                rv.gauntlet = true;
+            }
+            else if (name == "--engine")
+            {
+                auto const engine{value()};
+                if (!engine)
+                {
+                    return std::nullopt;
+                }
+                rv.engines.emplace_back(*engine);
+            }
+            else if (name == "--openings")
+            {
+                auto const openings{value()};
+                if (!openings)
+                {
+                    return std::nullopt;
+                }
+                rv.openings = *openings;
+            }
+            else if (name == "--rounds" || name == "--concurrency")
+            {
+                auto const count{
+                    value().and_then(pawn::parse_number<uint32_t>)};
+                if (!count || *count == 0)
+                {
+                    return std::nullopt;
+                }
+                (name == "--rounds" ? rv.rounds : rv.concurrency) = *count;
+            }
+            else if (name == "--standby")
+            {
+                auto const count{
+                    value().and_then(pawn::parse_number<uint32_t>)};
+                if (!count)
+                {
+                    return std::nullopt;
+                }
+                rv.standby = *count;
+            }
+            else if (name == "--cpus" || name == "--numa")
+            {
+                auto const cpus{name == "--cpus"
+                        ? value().and_then(pawn::parse_cpu_list)
+                        : value()
+                              .and_then(pawn::parse_number<uint32_t>)
+                              .and_then(pawn::numa_node_cpus)};
+                if (!cpus)
+                {
+                    return std::nullopt;
+                }
+                rv.cpus = *cpus;
+            }
+            else if (name == "--metrics")
+            {
+                auto const metrics{value()};
+                if (!metrics)
+                {
+                    return std::nullopt;
+                }
+                rv.metrics = *metrics;
+            }
+            else if (name == "--tc")
+            {
+                auto const control{value().and_then(pawn::parse_time_control)};
+                if (!control)
+                {
+                    return std::nullopt;
+                }
+                rv.time_control = *control;
+            }
+            else if (name == "--sprt")
+            {
+                auto const elo0{value().and_then(pawn::parse_number<double>)};
+                auto const elo1{value().and_then(pawn::parse_number<double>)};
+                if (!elo0 || !elo1 || *elo1 <= *elo0)
+                {
+                    return std::nullopt;
+                }
+                rv.sprt = pawn::sprt_parameters{.elo0 = *elo0, .elo1 = *elo1};
+            }
+            else
+            {
+                return std::nullopt;
+            }
+        }
+
+        if (rv.engines.size() < 2)
+        {
+            return std::nullopt;
+        }
+
+        return rv;
+    }
+
+    // Reports the reason if the openings can't be read
+    [[nodiscard]] std::optional<std::vector<std::vector<pawn::uci_move>>>
+    read_openings(std::filesystem::path const& path)
+    {
+        std::ifstream stream{path};
+        if (!stream)
+        {
+            fmt::print(stderr, "Can't open {}\n", path.string());
+            return std::nullopt;
+        }
+
+        std::vector<std::vector<pawn::uci_move>> rv;
+        std::string line;
+        for (size_t number{1}; std::getline(stream, line); ++number)
+        {
+            std::istringstream moves{line};
+            std::vector<pawn::uci_move> opening;
+            for (auto move{std::istream_iterator<std::string>{moves}};
+                 move != std::istream_iterator<std::string>{};
+                 ++move)
+            {
+                if (opening.empty() && move->starts_with('#'))
+                {
+                    break;
+                }
+
+                std::optional<pawn::uci_move> const parsed{
+                    pawn::parse_move(*move)};
+                if (!parsed)
+                {
+                    fmt::print(stderr,
+                        "Invalid move {} on line {} of {}\n",
+                        *move,
+                        number,
+                        path.string());
+                    return std::nullopt;
+                }
+                opening.push_back(*parsed);
+            }
+
+            if (!opening.empty())
+            {
+                rv.push_back(std::move(opening));
+            }
+        }
+        return rv;
+    }
+
+    struct [[nodiscard]] pairing final
+    {
+        size_t first;
+        size_t second;
+        pawn::match_score score;
+        bool concluded;
+    };
+
+    struct [[nodiscard]] scheduled_game final
+    {
+        size_t pairing;
+        size_t opening;
+        // The second engine of the pairing plays white
+        bool reversed;
+    };
+
+    // Samples of an engine process taken before and after a game
+    struct [[nodiscard]] engine_samples final
+    {
+        std::optional<pawn::process_usage> before;
+        std::optional<pawn::process_usage> after;
+    };
+
+    class [[nodiscard]] tournament final
+    {
+    public:
+        tournament(tournament_options options,
+            std::vector<std::vector<pawn::uci_move>> openings,
+            std::ostream* const metrics)
+            : options_{std::move(options)}
+            , openings_{std::move(openings)}
+            , metrics_{metrics}
+        {
+            if (metrics_)
+            {
+                *metrics_ << "game,color,engine,cpu_ms,rss_bytes,threads,"
+                             "voluntary_context_switches,"
+                             "involuntary_context_switches\n";
+            }
+
+            size_t const engines{options_.engines.size()};
+            for (size_t first{}; first != engines; ++first)
+            {
+                for (size_t second{first + 1}; second != engines; ++second)
+                {
+                    if (!options_.gauntlet || first == 0)
+                    {
+                        pairings_.push_back({.first = first,
+                            .second = second,
+                            .score = {},
+                            .concluded = false});
+                    }
+                }
+            }
+
+            for (uint32_t round{}; round != options_.rounds; ++round)
+            {
+                for (size_t opening{}; opening != openings_.size(); ++opening)
+                {
+                    for (size_t index{}; index != pairings_.size(); ++index)
+                    {
+                        schedule_.push_back({index, opening, false});
+                        schedule_.push_back({index, opening, true});
+                    }
+                }
+            }
+        }
+
+        tournament(tournament const&) = delete;
+
+        tournament(tournament&&) noexcept = delete;
+
+    public:
+        ~tournament() = default;
+
+    public:
+        // Returns false if an engine couldn't be started
+        [[nodiscard]] bool run()
+        {
+            {
+                uint32_t const threads{
+                    std::min(options_.concurrency, game_threads)};
+                std::deque<pawn::uci_reactor> reactors(threads);
+                asio::io_context context{static_cast<int>(threads)};
+                for (uint32_t i{}; i != options_.concurrency; ++i)
+                {
+                    asio::co_spawn(context,
+                        play_games(i, reactors[i % threads]),
+                        [this](std::exception_ptr const& error)
+                        {
+                            if (error)
+                            {
+                                failed_ = true;
+                            }
+                        });
+                }
+
+                std::vector<std::jthread> workers;
+                for (uint32_t i{}; i != threads; ++i)
+                {
+                    workers.emplace_back([&context]() { context.run(); });
+                }
+            }
+
+            fmt::print("\nFinal standings\n");
+            for (pairing const& p : pairings_)
+            {
+                print_standing(p);
+            }
+
+            return !failed_;
+        }
+
+    public:
+        tournament& operator=(tournament const&) = delete;
+
+        tournament& operator=(tournament&&) noexcept = delete;
+
+    private:
+        // Each worker plays one game at a time, its engines are kept running
+        // between the games
+        [[nodiscard]] asio::awaitable<void> play_games(uint32_t const worker,
+            pawn::uci_reactor& reactor)
+        {
+            pawn::uci_engine_standby standby{reactor,
+                {.profile = engine_profile,
+                    .watchdog = {},
+                    .standby = options_.standby}};
+            while (!failed_)
+            {
+                size_t const index{next_game_.fetch_add(1)};
+                if (index >= schedule_.size())
+                {
+                    co_return;
+                }
+
+                scheduled_game const& game{schedule_[index]};
+                auto const [white, black]{engines(game)};
+                if (!white)
+                {
+                    continue;
+                }
+
+                try
+                {
+                    pawn::uci_engine white_engine{
+                        co_await standby.async_acquire(
+                            options_.engines[*white])};
+                    pawn::uci_engine black_engine{
+                        co_await standby.async_acquire(
+                            options_.engines[black])};
+                    pin(worker, white_engine);
+                    pin(worker, black_engine);
+
+                    // The clock isn't charged for starting the engines
+                    pawn::uci_session white_session{white_engine};
+                    pawn::uci_session black_session{black_engine};
+                    co_await white_session.isready();
+                    co_await black_session.isready();
+
+                    std::array<engine_samples, 2> samples{
+                        engine_samples{.before = white_engine.resource_usage(),
+                            .after = {}},
+                        engine_samples{.before = black_engine.resource_usage(),
+                            .after = {}}};
+
+                    pawn::game_record const record{
+                        co_await pawn::play_game(white_session,
+                            black_session,
+                            openings_[game.opening],
+                            options_.time_control,
+                            options_.adjudication)};
+
+                    samples[0].after = white_engine.resource_usage();
+                    samples[1].after = black_engine.resource_usage();
+                    standby.release(std::move(white_engine));
+                    standby.release(std::move(black_engine));
+                    report(game, record, samples);
+                }
+                catch (std::exception const& e)
+                {
+                    std::lock_guard const lock{results_mutex_};
+                    fmt::print(stderr, "Unable to play a game: {}\n", e.what());
+                    failed_ = true;
+                }
+            }
+        }
+
+        // Engines of a worker share a CPU, they don't search at the same time
+        void pin(uint32_t const worker, pawn::uci_engine& engine)
+        {
+            if (options_.cpus.empty())
+            {
+                return;
+            }
+
+            uint32_t const cpu{options_.cpus[worker % options_.cpus.size()]};
+            if (!engine.set_affinity({cpu}))
+            {
+                std::lock_guard const lock{results_mutex_};
+                fmt::print(stderr, "Unable to pin an engine to CPU {}\n", cpu);
+            }
+        }
+
+        // White is empty if the pairing was already concluded
+        [[nodiscard]] std::pair<std::optional<size_t>, size_t> engines(
+            scheduled_game const& game)
+        {
+            std::lock_guard const lock{results_mutex_};
+
+            pairing const& p{pairings_[game.pairing]};
+            if (p.concluded)
+            {
+                return {std::nullopt, 0};
+            }
+
+            return game.reversed ? std::pair{std::optional{p.second}, p.first}
+                                 : std::pair{std::optional{p.first}, p.second};
+        }
+
+        void report(scheduled_game const& game,
+            pawn::game_record const& record,
+            std::array<engine_samples, 2> const& samples)
+        {
+            std::lock_guard const lock{results_mutex_};
+
+            pairing& p{pairings_[game.pairing]};
+            bool const first_is_white{!game.reversed};
+            switch (record.outcome)
+            {
+            case pawn::game_outcome::draw:
+                ++p.score.draws;
+                break;
+            case pawn::game_outcome::white_wins:
+                ++(first_is_white ? p.score.wins : p.score.losses);
+                break;
+            case pawn::game_outcome::black_wins:
+                ++(first_is_white ? p.score.losses : p.score.wins);
+                break;
+            }
+
+            ++games_played_;
+            fmt::print("Game {} of {}, opening {}: {} - {}, {} by {} after {} "
+                       "plies\n",
+                games_played_,
+                schedule_.size(),
+                game.opening + 1,
+                options_.engines[first_is_white ? p.first : p.second],
+                options_.engines[first_is_white ? p.second : p.first],
+                outcome_string(record.outcome),
+                to_string_view(record.termination),
+                record.moves.size());
+            print_standing(p);
+
+            if (metrics_)
+            {
+                write_metrics(samples[0],
+                    "white",
+                    options_.engines[first_is_white ? p.first : p.second]);
+                write_metrics(samples[1],
+                    "black",
+                    options_.engines[first_is_white ? p.second : p.first]);
+            }
+
+            if (options_.sprt && !p.concluded)
+            {
+                pawn::sprt_status const status{
+                    pawn::sprt(p.score, *options_.sprt)};
+                if (status.state != pawn::sprt_state::running)
+                {
+                    p.concluded = true;
+                    fmt::print("SPRT {} vs {}: {} accepted\n",
+                        options_.engines[p.first],
+                        options_.engines[p.second],
+                        status.state == pawn::sprt_state::accepted_h1 ? "H1"
+                                                                      : "H0");
+                }
+            }
+            std::fflush(stdout);
+        }
+
+        // CPU time and context switches are counted during the game, engine
+        // processes are reused so their totals include earlier games
+        void write_metrics(engine_samples const& samples,
+            std::string_view const color,
+            std::string_view const engine)
+        {
+            if (!samples.before || !samples.after)
+            {
+                return;
+            }
+
+            pawn::process_usage const& before{*samples.before};
+            pawn::process_usage const& after{*samples.after};
+            auto const cpu_time{
+                (after.user_time + after.system_time) -
+                (before.user_time + before.system_time)};
+
+            std::string quoted{engine};
+            for (size_t i{quoted.find('"')}; i != std::string::npos;
+                 i = quoted.find('"', i + 2))
+            {
+                quoted.insert(i, 1, '"');
+            }
+
+            *metrics_ << fmt::format("{},{},\"{}\",{},{},{},{},{}\n",
+                games_played_,
+                color,
+                quoted,
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    cpu_time)
+                    .count(),
+                after.resident_bytes,
+                after.threads,
+                after.voluntary_context_switches -
+                    before.voluntary_context_switches,
+                after.involuntary_context_switches -
+                    before.involuntary_context_switches);
+            metrics_->flush();
+        }
+
+        void print_standing(pairing const& p) const
+        {
+            std::string line{fmt::format("{} vs {}: +{} ={} -{}",
+                options_.engines[p.first],
+                options_.engines[p.second],
+                p.score.wins,
+                p.score.draws,
+                p.score.losses)};
+
+            if (std::optional<pawn::elo_estimate> const estimate{
+                    pawn::estimate_elo(p.score)})
+            {
+                fmt::format_to(std::back_inserter(line),
+                    ", Elo {:+.1f} +/- {:.1f}",
+                    estimate->elo,
+                    estimate->margin);
+            }
+
+            if (options_.sprt)
+            {
+                pawn::sprt_status const status{
+                    pawn::sprt(p.score, *options_.sprt)};
+                fmt::format_to(std::back_inserter(line),
+                    ", LLR {:.2f} ({:.2f}, {:.2f})",
+                    status.llr,
+                    status.lower_bound,
+                    status.upper_bound);
+            }
+
+            fmt::print("{}\n", line);
+        }
+
+        [[nodiscard]] static std::string_view outcome_string(
+            pawn::game_outcome const outcome)
+        {
+            switch (outcome)
+            {
+            case pawn::game_outcome::white_wins:
+                return "1-0";
+            case pawn::game_outcome::black_wins:
+                return "0-1";
+            case pawn::game_outcome::draw:
+                return "1/2-1/2";
+            }
+            return {};
+        }
+
+    private:
+        tournament_options options_;
+        std::vector<std::vector<pawn::uci_move>> openings_;
+        std::ostream* metrics_;
+        std::vector<scheduled_game> schedule_;
+        std::atomic<size_t> next_game_{};
+        std::atomic<bool> failed_{};
+
+        std::mutex results_mutex_;
+        std::vector<pairing> pairings_;
+        size_t games_played_{};
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::optional<tournament_options> options{parse_options(argc, argv)};
+    if (!options)
+    {
+        fmt::print(stderr,
+            "usage: pawn_tournament --engine <command line> --engine "
+            "<command line> [...] [--gauntlet] [--openings <file>] "
+            "[--rounds <n>] [--concurrency <n>] [--tc <time control>] "
+            "[--sprt <elo0> <elo1>] [--standby <n>] "
+            "[--cpus <list> | --numa <node>] [--metrics <file>]\n");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::vector<pawn::uci_move>> openings{{}};
+    if (options->openings)
+    {
+        auto from_file{read_openings(*options->openings)};
+        if (!from_file)
+        {
+            return EXIT_FAILURE;
+        }
+
+        if (from_file->empty())
+        {
+            fmt::print(stderr,
+                "No openings in {}\n",
+                options->openings->string());
+            return EXIT_FAILURE;
+        }
+        openings = std::move(*from_file);
+    }
+
+    std::ofstream metrics;
+    if (options->metrics)
+    {
+        metrics.open(*options->metrics);
+        if (!metrics)
+        {
+            fmt::print(stderr,
+                "Unable to write {}\n",
+                options->metrics->string());
+            return EXIT_FAILURE;
+        }
+    }
+
+    tournament runner{std::move(*options),
+        std::move(openings),
+        metrics.is_open() ? &metrics : nullptr};
+    return runner.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,68 @@
+#include <position_command.hpp>
+
+#include <algorithm>
+
+namespace
+{
+    constexpr std::string_view startpos{"position startpos"};
+    constexpr std::string_view moves_separator{" moves"};
+} // namespace
+
+pawn::position_command::position_command() : buffer_{startpos} { }
+
+std::string_view pawn::position_command::update(
+    std::span<uci_move const> moves)
+{
+    if (fen_)
+    {
+        buffer_ = startpos;
+        moves_.clear();
+        move_ends_.clear();
+        fen_ = false;
+    }
+
+    auto const common{static_cast<size_t>(
+        std::ranges::mismatch(moves_, moves).in1 - moves_.begin())};
+
+    moves_.resize(common);
+    move_ends_.resize(common);
+    if (common == 0)
+    {
+        buffer_.resize(startpos.size());
+        if (!moves.empty())
+        {
+            buffer_.append(moves_separator);
+        }
+    }
+    else
+    {
+        buffer_.resize(move_ends_.back());
+    }
+
+    for (uci_move const move : moves.subspan(common))
+    {
+        size_t const begin{buffer_.size()};
+        buffer_.resize(begin + 1 + uci_move::max_length);
+        buffer_[begin] = ' ';
+        buffer_.resize(static_cast<size_t>(
+            move.to_chars(buffer_.data() + begin + 1) - buffer_.data()));
+
+        moves_.push_back(move);
+        move_ends_.push_back(buffer_.size());
+    }
+
+    return buffer_;
+}
+
+std::string_view pawn::position_command::update(std::string_view fen)
+{
+    buffer_.assign("position fen ");
+    buffer_.append(fen);
+    moves_.clear();
+    move_ends_.clear();
+    fen_ = true;
+
+    return buffer_;
+}
+
+std::string_view pawn::position_command::command() const { return buffer_; }
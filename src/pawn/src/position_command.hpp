@@ -0,0 +1,48 @@
+#ifndef PAWN_POSITION_COMMAND_INCLUDED
+#define PAWN_POSITION_COMMAND_INCLUDED
+
+#include <uci_move.hpp>
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    // Keeps the last position command so that a position which extends the
+    // previous one only appends the new moves, without reformatting the game
+    class [[nodiscard]] position_command final
+    {
+    public:
+        position_command();
+
+        position_command(position_command const&) = default;
+
+        position_command(position_command&&) noexcept = default;
+
+    public:
+        ~position_command() = default;
+
+    public:
+        std::string_view update(std::span<uci_move const> moves);
+
+        std::string_view update(std::string_view fen);
+
+        [[nodiscard]] std::string_view command() const;
+
+    public:
+        position_command& operator=(position_command const&) = default;
+
+        position_command& operator=(position_command&&) noexcept = default;
+
+    private:
+        std::string buffer_;
+        std::vector<uci_move> moves_;
+        std::vector<size_t> move_ends_;
+        bool fen_{false};
+    };
+} // namespace pawn
+
+#endif
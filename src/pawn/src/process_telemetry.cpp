@@ -0,0 +1,292 @@
+#include <process_telemetry.hpp>
+
+#include <text_parse.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    [[nodiscard]] std::chrono::microseconds ticks_to_duration(
+        uint64_t const ticks,
+        int64_t const ticks_per_second)
+    {
+        return std::chrono::microseconds{
+            static_cast<int64_t>(ticks) * 1'000'000 / ticks_per_second};
+    }
+
+#ifdef __linux__
+    // Files in /proc report a size of zero, they are read until the end
+    [[nodiscard]] std::optional<std::string> read_file(
+        std::filesystem::path const& path)
+    {
+        std::ifstream stream{path, std::ios::binary};
+        if (!stream)
+        {
+            return std::nullopt;
+        }
+        return std::string{std::istreambuf_iterator<char>{stream}, {}};
+    }
+
+    [[nodiscard]] std::vector<int64_t> process_threads(int64_t const pid)
+    {
+        std::vector<int64_t> rv;
+
+        std::error_code error;
+        for (std::filesystem::directory_iterator it{
+                 std::filesystem::path{"/proc"} / std::to_string(pid) / "task",
+                 error};
+             !error && it != std::filesystem::directory_iterator{};
+             it.increment(error))
+        {
+            if (auto const tid{pawn::parse_number<int64_t>(
+                    it->path().filename().string())})
+            {
+                rv.push_back(*tid);
+            }
+        }
+
+        return rv;
+    }
+#endif
+} // namespace
+
+std::optional<pawn::process_usage> pawn::parse_proc_stat(
+    std::string_view const stat,
+    int64_t const ticks_per_second)
+{
+    // The command name is in parentheses and may contain spaces
+    auto const name_end{stat.rfind(')')};
+    if (name_end == std::string_view::npos || ticks_per_second <= 0)
+    {
+        return std::nullopt;
+    }
+
+    // Fields after the name start with the state, which is the third
+    std::vector<std::string_view> fields;
+    std::string_view rest{stat.substr(name_end + 1)};
+    while (!(rest = trim(rest)).empty())
+    {
+        auto const end{rest.find(' ')};
+        fields.push_back(rest.substr(0, end));
+        rest = end == std::string_view::npos ? std::string_view{}
+                                             : rest.substr(end);
+    }
+
+    constexpr size_t utime{14 - 3};
+    constexpr size_t stime{15 - 3};
+    constexpr size_t num_threads{20 - 3};
+    if (fields.size() <= num_threads)
+    {
+        return std::nullopt;
+    }
+
+    auto const user{parse_number<uint64_t>(fields[utime])};
+    auto const system{parse_number<uint64_t>(fields[stime])};
+    auto const threads{parse_number<uint32_t>(fields[num_threads])};
+    if (!user || !system || !threads)
+    {
+        return std::nullopt;
+    }
+
+    return process_usage{
+        .user_time = ticks_to_duration(*user, ticks_per_second),
+        .system_time = ticks_to_duration(*system, ticks_per_second),
+        .resident_bytes = 0,
+        .voluntary_context_switches = 0,
+        .involuntary_context_switches = 0,
+        .threads = *threads};
+}
+
+void pawn::parse_proc_status(std::string_view status, process_usage& usage)
+{
+    while (!status.empty())
+    {
+        auto const line_end{status.find('\n')};
+        std::string_view const line{status.substr(0, line_end)};
+        status = line_end == std::string_view::npos
+            ? std::string_view{}
+            : status.substr(line_end + 1);
+
+        auto const separator{line.find(':')};
+        if (separator == std::string_view::npos)
+        {
+            continue;
+        }
+
+        std::string_view const name{line.substr(0, separator)};
+        std::string_view value{trim(line.substr(separator + 1))};
+        if (name == "VmRSS" && value.ends_with(" kB"))
+        {
+            value.remove_suffix(3);
+            if (auto const kilobytes{parse_number<uint64_t>(value)})
+            {
+                usage.resident_bytes = *kilobytes * 1024;
+            }
+        }
+        else if (name == "voluntary_ctxt_switches")
+        {
+            usage.voluntary_context_switches =
+                parse_number<uint64_t>(value).value_or(0);
+        }
+        else if (name == "nonvoluntary_ctxt_switches")
+        {
+            usage.involuntary_context_switches =
+                parse_number<uint64_t>(value).value_or(0);
+        }
+    }
+}
+
+std::optional<std::vector<uint32_t>> pawn::parse_cpu_list(
+    std::string_view list)
+{
+    list = trim(list);
+    if (list.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<uint32_t> rv;
+    while (!list.empty())
+    {
+        auto const end{list.find(',')};
+        std::string_view const range{list.substr(0, end)};
+        list = end == std::string_view::npos ? std::string_view{}
+                                             : list.substr(end + 1);
+
+        auto const dash{range.find('-')};
+        auto const first{parse_number<uint32_t>(range.substr(0, dash))};
+        auto const last{dash == std::string_view::npos
+                ? first
+                : parse_number<uint32_t>(range.substr(dash + 1))};
+        if (!first || !last || *last < *first)
+        {
+            return std::nullopt;
+        }
+
+        for (uint32_t cpu{*first}; cpu <= *last; ++cpu)
+        {
+            rv.push_back(cpu);
+        }
+    }
+    return rv;
+}
+
+#ifdef __linux__
+std::optional<pawn::process_usage> pawn::sample_process(int64_t const pid)
+{
+    std::filesystem::path const directory{
+        std::filesystem::path{"/proc"} / std::to_string(pid)};
+
+    std::optional<std::string> const stat{read_file(directory / "stat")};
+    std::optional<std::string> const status{read_file(directory / "status")};
+    if (!stat || !status)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<process_usage> rv{
+        parse_proc_stat(*stat, sysconf(_SC_CLK_TCK))};
+    if (!rv)
+    {
+        return std::nullopt;
+    }
+    parse_proc_status(*status, *rv);
+
+    // Context switches of the process status are those of its main thread
+    uint64_t voluntary{};
+    uint64_t involuntary{};
+    for (int64_t const tid : process_threads(pid))
+    {
+        if (std::optional<std::string> const thread_status{read_file(
+                directory / "task" / std::to_string(tid) / "status")})
+        {
+            process_usage thread;
+            parse_proc_status(*thread_status, thread);
+            voluntary += thread.voluntary_context_switches;
+            involuntary += thread.involuntary_context_switches;
+        }
+    }
+    rv->voluntary_context_switches = voluntary;
+    rv->involuntary_context_switches = involuntary;
+
+    return rv;
+}
+
+std::optional<std::vector<uint32_t>> pawn::numa_node_cpus(
+    uint32_t const node)
+{
+    std::optional<std::string> const list{
+        read_file(std::filesystem::path{"/sys/devices/system/node"} /
+            ("node" + std::to_string(node)) / "cpulist")};
+    if (!list)
+    {
+        return std::nullopt;
+    }
+    return parse_cpu_list(*list);
+}
+
+bool pawn::set_process_affinity(int64_t const pid,
+    std::span<uint32_t const> const cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t const cpu : cpus)
+    {
+        if (cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+
+    std::vector<int64_t> const threads{process_threads(pid)};
+    if (cpus.empty() || threads.empty())
+    {
+        return false;
+    }
+
+    bool rv{true};
+    for (int64_t const tid : threads)
+    {
+        if (sched_setaffinity(static_cast<pid_t>(tid), sizeof(set), &set) != 0)
+        {
+            rv = false;
+        }
+    }
+    return rv;
+}
+#else
+std::optional<pawn::process_usage> pawn::sample_process(
+    [[maybe_unused]] int64_t const pid)
+{
+    return std::nullopt;
+}
+
+std::optional<std::vector<uint32_t>> pawn::numa_node_cpus(
+    [[maybe_unused]] uint32_t const node)
+{
+    return std::nullopt;
+}
+
+bool pawn::set_process_affinity([[maybe_unused]] int64_t const pid,
+    [[maybe_unused]] std::span<uint32_t const> const cpus)
+{
+    return false;
+}
+#endif
@@ -0,0 +1,50 @@
+#ifndef PAWN_PROCESS_TELEMETRY_INCLUDED
+#define PAWN_PROCESS_TELEMETRY_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    struct [[nodiscard]] process_usage final
+    {
+        std::chrono::microseconds user_time{};
+        std::chrono::microseconds system_time{};
+        uint64_t resident_bytes{};
+        // Summed over the threads which are still running
+        uint64_t voluntary_context_switches{};
+        uint64_t involuntary_context_switches{};
+        uint32_t threads{};
+    };
+
+    // Times and thread count from the contents of /proc/<pid>/stat
+    [[nodiscard]] std::optional<process_usage> parse_proc_stat(
+        std::string_view stat,
+        int64_t ticks_per_second);
+
+    // Resident set size and context switches from the contents of
+    // /proc/<pid>/status, other fields are left as they are
+    void parse_proc_status(std::string_view status, process_usage& usage);
+
+    // Linux CPU list format, e.g. 0-3,8,10-11
+    [[nodiscard]] std::optional<std::vector<uint32_t>> parse_cpu_list(
+        std::string_view list);
+
+    // Empty if the process doesn't exist or the platform isn't supported
+    [[nodiscard]] std::optional<process_usage> sample_process(int64_t pid);
+
+    [[nodiscard]] std::optional<std::vector<uint32_t>> numa_node_cpus(
+        uint32_t node);
+
+    // Applies to all threads of the process, threads started afterwards
+    // inherit the affinity of the thread which starts them. Returns false if
+    // the platform isn't supported or a CPU isn't available.
+    [[nodiscard]] bool set_process_affinity(int64_t pid,
+        std::span<uint32_t const> cpus);
+} // namespace pawn
+
+#endif
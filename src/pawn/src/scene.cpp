@@ -1,5 +1,5 @@
 #include <scene.hpp>
-#include <uci_engine.hpp>
+#include <engine_log.hpp>
 
 #include <gltf_manager.hpp>
 #include <vulkan_buffer.hpp>
@@ -220,6 +220,32 @@ namespace
 
         return rv;
     }
+
+    void draw_engine_log(char const* const title,
+        std::string_view const usage,
+        pawn::engine_log& log)
+    {
+        ImGui::Begin(title);
+        if (!usage.empty())
+        {
+            ImGui::TextUnformatted(usage.data(), usage.data() + usage.size());
+            ImGui::Separator();
+        }
+
+        log.update();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(cppext::narrow<int>(log.size()));
+        while (clipper.Step())
+        {
+            for (int i{clipper.DisplayStart}; i != clipper.DisplayEnd; ++i)
+            {
+                std::string_view const line{log.line(static_cast<size_t>(i))};
+                ImGui::TextUnformatted(line.data(), line.data() + line.size());
+            }
+        }
+        ImGui::End();
+    }
 } // namespace
 
 glm::fvec3 pawn::orthographic_camera::position() const { return front_face_; }
@@ -250,7 +276,11 @@ float pawn::orthographic_camera::far_plane() const
     return position_.z + projection_[2];
 }
 
-pawn::scene::scene(uci_engine const& engine) : engine_{&engine} { }
+pawn::scene::scene(engine_log& white_engine_log, engine_log& black_engine_log)
+    : white_engine_log_{&white_engine_log}
+    , black_engine_log_{&black_engine_log}
+{
+}
 
 pawn::scene::~scene() = default;
 
@@ -583,6 +613,21 @@ void pawn::scene::update(orthographic_camera const& camera)
     }
 }
 
+void pawn::scene::set_analysis(std::string text)
+{
+    analysis_ = std::move(text);
+}
+
+void pawn::scene::set_engine_usage(piece_color const side, std::string text)
+{
+    engine_usage_[std::to_underlying(side) - 1] = std::move(text);
+}
+
+void pawn::scene::set_game_result(std::string text)
+{
+    game_result_ = std::move(text);
+}
+
 VkClearValue pawn::scene::clear_color() { return {{{1.f, .5f, .3f, 1.f}}}; }
 
 VkClearValue pawn::scene::clear_depth() { return {.depthStencil = {1.0f, 0}}; }
@@ -710,6 +755,8 @@ void pawn::scene::draw(VkCommandBuffer command_buffer, VkExtent2D extent)
 
 void pawn::scene::draw_imgui()
 {
+    // Tuning the light is only for development
+#ifndef NDEBUG
     ImGui::Begin("Light");
     ImGui::SliderFloat3("Position",
         glm::value_ptr(light_position_),
@@ -717,12 +764,29 @@ void pawn::scene::draw_imgui()
         1.0f);
     ImGui::SliderFloat3("Color", glm::value_ptr(light_color_), 0.0f, 1.0f);
     ImGui::End();
+#endif
+
+    draw_engine_log("White engine", engine_usage_[0], *white_engine_log_);
+    draw_engine_log("Black engine", engine_usage_[1], *black_engine_log_);
 
-    ImGui::Begin("Engine debug");
-    for (std::string const& line : engine_->debug_output())
+    if (!analysis_.empty())
     {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
-        ImGui::Text("%s", line.c_str());
+        ImGui::Begin("Analysis");
+        ImGui::TextUnformatted(analysis_.data(),
+            analysis_.data() + analysis_.size());
+        ImGui::End();
+    }
+
+    // Appears in the middle of the board, on top of the other windows
+    if (!game_result_.empty())
+    {
+        ImGuiViewport const* const viewport{ImGui::GetMainViewport()};
+        ImGui::SetNextWindowPos(viewport->GetCenter(),
+            ImGuiCond_Appearing,
+            ImVec2{0.5f, 0.5f});
+        ImGui::Begin("Game", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::TextUnformatted(game_result_.data(),
+            game_result_.data() + game_result_.size());
+        ImGui::End();
     }
-    ImGui::End();
 }
@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -31,7 +32,7 @@ namespace vkrndr
 
 namespace pawn
 {
-    class uci_engine;
+    class engine_log;
 } // namespace pawn
 
 namespace pawn
@@ -90,7 +91,7 @@ namespace pawn
     class [[nodiscard]] scene final : public vkrndr::vulkan_scene
     {
     public: // Construction
-        explicit scene(uci_engine const& engine);
+        scene(engine_log& white_engine_log, engine_log& black_engine_log);
 
         scene(scene const&) = delete;
 
@@ -113,6 +114,15 @@ namespace pawn
 
         void update(orthographic_camera const& camera);
 
+        // Shown in a window while not empty
+        void set_analysis(std::string text);
+
+        // Shown above the log of the engine
+        void set_engine_usage(piece_color side, std::string text);
+
+        // Shown in a window once the game is over
+        void set_game_result(std::string text);
+
     public: // vulkan_scene overrides
         [[nodiscard]] VkClearValue clear_color() override;
 
@@ -138,7 +148,12 @@ namespace pawn
         };
 
     private: // Data
-        uci_engine const* engine_{};
+        engine_log* white_engine_log_{};
+        engine_log* black_engine_log_{};
+        std::string analysis_;
+        std::string game_result_;
+        // Indexed by the color of the side
+        std::array<std::string, 2> engine_usage_;
 
         vkrndr::vulkan_device* vulkan_device_{};
         vkrndr::vulkan_renderer* vulkan_renderer_{};
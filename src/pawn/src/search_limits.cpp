@@ -0,0 +1,84 @@
+#include <search_limits.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace
+{
+    template<typename T>
+    void append_limit(std::string& command,
+        std::string_view const name,
+        std::optional<T> const& value)
+    {
+        if (!value)
+        {
+            return;
+        }
+
+        if constexpr (std::is_same_v<T, std::chrono::milliseconds>)
+        {
+            fmt::format_to(std::back_inserter(command),
+                " {} {}",
+                name,
+                std::max<std::chrono::milliseconds::rep>(value->count(), 0));
+        }
+        else
+        {
+            fmt::format_to(std::back_inserter(command), " {} {}", name, *value);
+        }
+    }
+} // namespace
+
+std::string pawn::go_command(search_limits const& limits)
+{
+    std::string rv;
+    append_go_command(rv, limits);
+    return rv;
+}
+
+std::optional<std::chrono::milliseconds> pawn::time_budget(
+    search_limits const& limits)
+{
+    if (limits.ponder || limits.infinite)
+    {
+        return std::nullopt;
+    }
+
+    if (limits.movetime)
+    {
+        return limits.movetime;
+    }
+
+    if (limits.wtime || limits.btime)
+    {
+        return std::max(limits.wtime.value_or(std::chrono::milliseconds{}),
+            limits.btime.value_or(std::chrono::milliseconds{}));
+    }
+
+    return std::nullopt;
+}
+
+void pawn::append_go_command(std::string& command,
+    search_limits const& limits)
+{
+    command.append(limits.ponder ? "go ponder" : "go");
+    append_limit(command, "wtime", limits.wtime);
+    append_limit(command, "btime", limits.btime);
+    append_limit(command, "winc", limits.winc);
+    append_limit(command, "binc", limits.binc);
+    append_limit(command, "movestogo", limits.movestogo);
+    append_limit(command, "depth", limits.depth);
+    append_limit(command, "nodes", limits.nodes);
+    append_limit(command, "movetime", limits.movetime);
+    if (limits.infinite)
+    {
+        command.append(" infinite");
+    }
+}
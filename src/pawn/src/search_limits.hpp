@@ -0,0 +1,36 @@
+#ifndef PAWN_SEARCH_LIMITS_INCLUDED
+#define PAWN_SEARCH_LIMITS_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace pawn
+{
+    struct [[nodiscard]] search_limits final
+    {
+        std::optional<std::chrono::milliseconds> wtime{};
+        std::optional<std::chrono::milliseconds> btime{};
+        std::optional<std::chrono::milliseconds> winc{};
+        std::optional<std::chrono::milliseconds> binc{};
+        std::optional<uint32_t> movestogo{};
+        std::optional<uint32_t> depth{};
+        std::optional<uint64_t> nodes{};
+        std::optional<std::chrono::milliseconds> movetime{};
+        bool ponder{};
+        // Searches until stopped, other limits are ignored by the engine
+        bool infinite{};
+    };
+
+    [[nodiscard]] std::string go_command(search_limits const& limits);
+
+    void append_go_command(std::string& command, search_limits const& limits);
+
+    // Longest time the engine may take to report its best move, empty if the
+    // search isn't limited by time
+    [[nodiscard]] std::optional<std::chrono::milliseconds> time_budget(
+        search_limits const& limits);
+} // namespace pawn
+
+#endif
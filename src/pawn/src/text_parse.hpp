@@ -0,0 +1,47 @@
+#ifndef PAWN_TEXT_PARSE_INCLUDED
+#define PAWN_TEXT_PARSE_INCLUDED
+
+#include <charconv>
+#include <optional>
+#include <string_view>
+#include <system_error>
+
+namespace pawn
+{
+    // Same set as std::isspace in the C locale, without the locale lookup
+    [[nodiscard]] constexpr bool is_space(char const c)
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    [[nodiscard]] constexpr std::string_view trim(std::string_view text)
+    {
+        while (!text.empty() && is_space(text.front()))
+        {
+            text.remove_prefix(1);
+        }
+
+        while (!text.empty() && is_space(text.back()))
+        {
+            text.remove_suffix(1);
+        }
+
+        return text;
+    }
+
+    // Fails unless the whole text is the number
+    template<typename T>
+    [[nodiscard]] std::optional<T> parse_number(std::string_view const text)
+    {
+        T rv; // NOLINT
+        auto const [end, error]{
+            std::from_chars(text.data(), text.data() + text.size(), rv)};
+        if (error != std::errc{} || end != text.data() + text.size())
+        {
+            return std::nullopt;
+        }
+        return rv;
+    }
+} // namespace pawn
+
+#endif
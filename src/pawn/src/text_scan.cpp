@@ -0,0 +1,231 @@
+#include <text_scan.hpp>
+
+#include <text_parse.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PAWN_TEXT_SCAN_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(PAWN_TEXT_SCAN_X86) && defined(__GNUC__)
+#define PAWN_TARGET_AVX2 [[gnu::target("avx2")]]
+#else
+#define PAWN_TARGET_AVX2
+#endif
+
+namespace
+{
+    using scan_function = char const* (*) (char const*, char const*);
+
+    struct [[nodiscard]] kernels final
+    {
+        pawn::scan_kernel kernel;
+        scan_function find_newline;
+        scan_function find_space;
+        scan_function find_non_space;
+    };
+
+    char const* scalar_find_newline(char const* first, char const* const last)
+    {
+        while (first != last && *first != '\n')
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    char const* scalar_find_space(char const* first, char const* const last)
+    {
+        while (first != last && !pawn::is_space(*first))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    char const* scalar_find_non_space(char const* first,
+        char const* const last)
+    {
+        while (first != last && pawn::is_space(*first))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    constexpr kernels scalar_kernels{pawn::scan_kernel::scalar,
+        scalar_find_newline,
+        scalar_find_space,
+        scalar_find_non_space};
+
+#ifdef PAWN_TEXT_SCAN_X86
+    // Each kernel tests a vector at a time while a whole vector is left and
+    // hands the tail to the scalar loop. Bits of the masks are set for the
+    // matching characters.
+
+    [[nodiscard]] __m128i sse2_space_mask(__m128i const chars)
+    {
+        // '\t' to '\r' are consecutive, after subtracting '\t' they are the
+        // values not above 4
+        __m128i const control{_mm_sub_epi8(chars, _mm_set1_epi8('\t'))};
+        return _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')),
+            _mm_cmpeq_epi8(_mm_min_epu8(control, _mm_set1_epi8(4)), control));
+    }
+
+    template<bool Space>
+    char const* sse2_find(char const* first, char const* const last)
+    {
+        for (; last - first >= 16; first += 16)
+        {
+            __m128i const chars{_mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(first))};
+            auto mask{static_cast<uint32_t>(
+                _mm_movemask_epi8(sse2_space_mask(chars)))};
+            if constexpr (!Space)
+            {
+                mask ^= 0xFFFF;
+            }
+            if (mask != 0)
+            {
+                return first + std::countr_zero(mask);
+            }
+        }
+        return Space ? scalar_find_space(first, last)
+                     : scalar_find_non_space(first, last);
+    }
+
+    char const* sse2_find_newline(char const* first, char const* const last)
+    {
+        __m128i const newline{_mm_set1_epi8('\n')};
+        for (; last - first >= 16; first += 16)
+        {
+            __m128i const chars{_mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(first))};
+            if (auto const mask{static_cast<uint32_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(chars, newline)))};
+                mask != 0)
+            {
+                return first + std::countr_zero(mask);
+            }
+        }
+        return scalar_find_newline(first, last);
+    }
+
+    constexpr kernels sse2_kernels{pawn::scan_kernel::sse2,
+        sse2_find_newline,
+        sse2_find<true>,
+        sse2_find<false>};
+
+    // Tokens are mostly shorter than 16 characters, wider vectors only pay
+    // off when searching for the end of a line
+    PAWN_TARGET_AVX2 char const* avx2_find_newline(char const* first,
+        char const* const last)
+    {
+        __m256i const newline{_mm256_set1_epi8('\n')};
+        for (; last - first >= 32; first += 32)
+        {
+            __m256i const chars{_mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(first))};
+            if (auto const mask{static_cast<uint32_t>(
+                    _mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, newline)))};
+                mask != 0)
+            {
+                return first + std::countr_zero(mask);
+            }
+        }
+        return sse2_find_newline(first, last);
+    }
+
+    constexpr kernels avx2_kernels{pawn::scan_kernel::avx2,
+        avx2_find_newline,
+        sse2_find<true>,
+        sse2_find<false>};
+
+    [[nodiscard]] bool avx2_supported()
+    {
+#ifdef _MSC_VER
+        // AVX2 support of the processor and saving of the YMM registers by
+        // the operating system
+        int registers[4]{};
+        __cpuid(registers, 1);
+        constexpr int osxsave{1 << 27};
+        if ((registers[2] & osxsave) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    [[nodiscard]] kernels const* find_kernels(pawn::scan_kernel const kernel)
+    {
+        switch (kernel)
+        {
+        case pawn::scan_kernel::scalar:
+            return &scalar_kernels;
+#ifdef PAWN_TEXT_SCAN_X86
+        case pawn::scan_kernel::sse2:
+            return &sse2_kernels;
+        case pawn::scan_kernel::avx2:
+            return avx2_supported() ? &avx2_kernels : nullptr;
+#endif
+        default:
+            return nullptr;
+        }
+    }
+
+    [[nodiscard]] kernels const* detect_kernels()
+    {
+        if (kernels const* const rv{find_kernels(pawn::scan_kernel::avx2)})
+        {
+            return rv;
+        }
+        if (kernels const* const rv{find_kernels(pawn::scan_kernel::sse2)})
+        {
+            return rv;
+        }
+        return &scalar_kernels;
+    }
+
+    kernels const* selected{detect_kernels()};
+} // namespace
+
+pawn::scan_kernel pawn::selected_scan_kernel() { return selected->kernel; }
+
+bool pawn::select_scan_kernel(scan_kernel const kernel)
+{
+    kernels const* const rv{find_kernels(kernel)};
+    if (rv)
+    {
+        selected = rv;
+    }
+    return rv != nullptr;
+}
+
+char const* pawn::find_newline(char const* const first,
+    char const* const last)
+{
+    return selected->find_newline(first, last);
+}
+
+char const* pawn::find_space(char const* const first, char const* const last)
+{
+    return selected->find_space(first, last);
+}
+
+char const* pawn::find_non_space(char const* const first,
+    char const* const last)
+{
+    return selected->find_non_space(first, last);
+}
@@ -0,0 +1,35 @@
+#ifndef PAWN_TEXT_SCAN_INCLUDED
+#define PAWN_TEXT_SCAN_INCLUDED
+
+#include <cstdint>
+
+namespace pawn
+{
+    // Instruction sets of the scanning kernels, the best one supported by
+    // the processor is picked at startup. Whitespace is searched with SSE2
+    // also by the AVX2 kernel.
+    enum class scan_kernel : uint8_t
+    {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    [[nodiscard]] scan_kernel selected_scan_kernel();
+
+    // Replaces the kernel used by the functions below, fails if the kernel
+    // is not supported. Not thread safe, meant for tests and benchmarks.
+    [[nodiscard]] bool select_scan_kernel(scan_kernel kernel);
+
+    // Each function returns last if nothing is found. Whitespace is the
+    // same set as std::isspace in the C locale.
+    [[nodiscard]] char const* find_newline(char const* first,
+        char const* last);
+
+    [[nodiscard]] char const* find_space(char const* first, char const* last);
+
+    [[nodiscard]] char const* find_non_space(char const* first,
+        char const* last);
+} // namespace pawn
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef PAWN_UCI_AST_INCLUDED
+#define PAWN_UCI_AST_INCLUDED
+
+#include <uci_move.hpp>
+
+#include <boost/optional/optional.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace pawn::ast
+{
+    struct [[nodiscard]] id final
+    {
+        std::string key;
+        std::string value;
+    };
+
+    enum option_type : uint8_t
+    {
+        check,
+        spin,
+        combo,
+        button,
+        string
+    };
+
+    struct [[nodiscard]] option final
+    {
+        std::string name;
+        option_type type;
+        boost::optional<std::string> def;
+        boost::optional<std::pair<int64_t, int64_t>> min_max;
+        std::vector<std::string> values;
+    };
+
+    struct [[nodiscard]] uciok final
+    {
+        bool dummy;
+    };
+
+    struct [[nodiscard]] bestmove final
+    {
+        std::string move;
+        std::string ponder;
+    };
+
+    enum info_field : uint32_t
+    {
+        depth = 1 << 0,
+        seldepth = 1 << 1,
+        time = 1 << 2,
+        nodes = 1 << 3,
+        pv = 1 << 4,
+        multipv = 1 << 5,
+        score = 1 << 6,
+        currmove = 1 << 7,
+        currmovenumber = 1 << 8,
+        hashfull = 1 << 9,
+        nps = 1 << 10,
+        tbhits = 1 << 11,
+        sbhits = 1 << 12,
+        cpuload = 1 << 13,
+        string_ = 1 << 14,
+        refutation = 1 << 15,
+        currline = 1 << 16,
+        wdl = 1 << 17
+    };
+
+    struct [[nodiscard]] info_score final
+    {
+        int32_t value;
+        bool mate;
+        bool lowerbound;
+        bool upperbound;
+    };
+
+    // Fixed capacity so that parsing a line doesn't allocate, principal
+    // variations longer than max_pv_length are truncated.
+    struct [[nodiscard]] info final
+    {
+        static constexpr size_t max_pv_length{64};
+
+        uint32_t fields;
+        uint32_t depth;
+        uint32_t seldepth;
+        uint32_t multipv;
+        info_score score;
+        uint64_t time;
+        uint64_t nodes;
+        uint64_t nps;
+        uint64_t tbhits;
+        uint64_t sbhits;
+        uint32_t hashfull;
+        uint32_t cpuload;
+        uint32_t currmovenumber;
+        uci_move currmove;
+        std::array<uint32_t, 3> wdl;
+        uint8_t pv_length;
+        std::array<uci_move, max_pv_length> pv;
+    };
+
+    [[nodiscard]] constexpr bool has_field(info const& info,
+        info_field const field)
+    {
+        return (info.fields & field) != 0;
+    }
+
+    // Views into the parsed line, valid as long as the line is. Produced by
+    // the tokenizing parser, which doesn't allocate.
+    struct [[nodiscard]] id_view final
+    {
+        std::string_view key;
+        std::string_view value;
+    };
+
+    // Combo values beyond max_values are dropped
+    struct [[nodiscard]] option_view final
+    {
+        static constexpr size_t max_values{32};
+
+        std::string_view name;
+        option_type type;
+        std::optional<std::string_view> def;
+        std::optional<std::pair<int64_t, int64_t>> min_max;
+        uint8_t values_length;
+        std::array<std::string_view, max_values> values;
+    };
+
+    // Progress of copy protection and registration checks
+    enum class status : uint8_t
+    {
+        checking,
+        ok,
+        error
+    };
+
+    // The null move stands for bestmove (none) and for a missing ponder move
+    struct [[nodiscard]] packed_bestmove final
+    {
+        uci_move move;
+        uci_move ponder;
+    };
+} // namespace pawn::ast
+
+#endif
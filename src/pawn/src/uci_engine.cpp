@@ -1,159 +1,1464 @@
 #include <uci_engine.hpp>
 
-#include <uci_parser.hpp>
+#include <analysis_cache.hpp>
+#include <engine_log.hpp>
+#include <line_buffer.hpp>
+#include <position_command.hpp>
+#include <process_telemetry.hpp>
+#include <uci_options.hpp>
+#include <uci_reactor.hpp>
+#include <uci_recording.hpp>
+#include <uci_tokenizer.hpp>
 
-#include <boost/algorithm/string/trim.hpp>
-#include <boost/circular_buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
 #define BOOST_PROCESS_USE_STD_FS
+#include <boost/process/async_pipe.hpp>
 #include <boost/process/child.hpp>
 #include <boost/process/io.hpp>
-#include <boost/process/pipe.hpp>
-#include <boost/spirit/home/x3.hpp>
+#include <boost/system/error_code.hpp>
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <chrono>
-#include <iostream>
-#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
 #include <utility>
 
+namespace asio = boost::asio;
 namespace bp = boost::process;
 
+namespace
+{
+    constexpr std::chrono::milliseconds quit_timeout{500};
+
+    // Results of searches bounded by time or nodes depend on the hardware
+    // and on the clock, only depth limited searches are reproducible
+    [[nodiscard]] bool cacheable(pawn::search_limits const& limits)
+    {
+        return limits.depth && !limits.ponder && !limits.infinite &&
+            !limits.wtime && !limits.btime && !limits.movetime &&
+            !limits.nodes;
+    }
+
+    [[nodiscard]] pawn::search_result cached_result(
+        pawn::cached_analysis&& analysis)
+    {
+        pawn::search_result rv{.move = analysis.move,
+            .ponder = analysis.ponder,
+            .info = {},
+            .received = std::chrono::steady_clock::now()};
+        rv.info.fields = pawn::ast::info_field::depth |
+            pawn::ast::info_field::nodes | pawn::ast::info_field::score;
+        rv.info.depth = analysis.depth;
+        rv.info.nodes = analysis.nodes;
+        rv.info.score = {.value = analysis.score,
+            .mate = analysis.mate,
+            .lowerbound = false,
+            .upperbound = false};
+        return rv;
+    }
+
+    // Tells apart the analyses of engines and settings sharing a cache. The
+    // move overhead only matters to searches bounded by time.
+    [[nodiscard]] std::string cache_configuration(
+        std::string_view const command_line,
+        pawn::option_profile const& profile,
+        std::span<pawn::option_setting const> const settings)
+    {
+        std::string rv{fmt::format("{}\nthreads {} hash {} multipv {}",
+            command_line,
+            profile.threads.value_or(0),
+            profile.hash.value_or(0),
+            profile.multipv.value_or(0))};
+        for (pawn::option_setting const& setting : settings)
+        {
+            fmt::format_to(std::back_inserter(rv),
+                "\n{} {}",
+                setting.name,
+                setting.value);
+        }
+        return rv;
+    }
+
+    [[nodiscard]] pawn::search_result failed_search()
+    {
+        pawn::search_result rv{};
+        rv.received = std::chrono::steady_clock::now();
+        return rv;
+    }
+} // namespace
+
 class [[nodiscard]] pawn::uci_engine::impl final
+    : public std::enable_shared_from_this<impl>
 {
 public:
-    explicit impl(std::string_view command_line)
-        : child_{command_line.data(),
-              bp::std_out > output_,
-              bp::std_in < input_}
+    impl(std::string_view command_line,
+        option_profile const& profile,
+        watchdog_options const& watchdog,
+        uci_recorder* const recorder,
+        asio::io_context& context)
+        : context_{&context}
+        , command_line_{command_line}
+        , input_{context}
+        , output_{context}
+        , child_{command_line_, bp::std_out > output_, bp::std_in < input_}
+        , spawned_{std::chrono::steady_clock::now()}
+        , watchdog_{watchdog}
+        , watchdog_timer_{context}
+        , profile_{profile}
+        , handshake_completion_{handshake_.get_future().share()}
+        , configuration_{cache_configuration(command_line_, profile_, {})}
+        , recorder_{recorder}
+        , pid_{static_cast<int64_t>(child_.id())}
     {
-        using boost::spirit::x3::ascii::space;
+    }
 
-        send_command("uci");
+    impl(impl const&) = delete;
+
+    impl(impl&&) noexcept = delete;
+
+public:
+    ~impl() = default;
+
+public:
+    void start()
+    {
+        asio::post(*context_,
+            [self = shared_from_this()]()
+            {
+                self->read_output();
+                self->send_command("uci");
+                self->schedule_watchdog();
+            });
+    }
+
+    [[nodiscard]] bool ready() const
+    {
+        return handshake_completion_.wait_for(std::chrono::seconds{0}) ==
+            std::future_status::ready;
+    }
+
+    void wait_until_ready() const { handshake_completion_.wait(); }
+
+    void shutdown()
+    {
+        auto exited{exited_.get_future()};
+
+        run_on_reactor(
+            [this]()
+            {
+                // Nothing is sent after quit
+                if (end_of_output_)
+                {
+                    exited_.set_value();
+                }
+                else
+                {
+                    send_command("quit");
+                }
+
+                stopped_ = true;
+                watchdog_timer_.cancel();
+                search_callback_ = nullptr;
+                pending_search_.reset();
+                early_ponder_result_.reset();
+                end_info_updates();
+
+                // Output read after quit isn't recorded, the recorder may be
+                // destroyed together with the engine
+                recorder_ = nullptr;
+            });
+
+        // The engine closes its output when it exits
+        static_cast<void>(exited.wait_for(quit_timeout));
+
+        std::error_code error;
+        if (child_.running(error))
+        {
+            child_.terminate(error);
+        }
+    }
+
+    [[nodiscard]] bool set_option(std::string_view name,
+        std::string_view value)
+    {
+        wait_until_ready();
 
-        std::string line;
-        while (std::getline(output_, line))
+        std::optional<option_setting> setting{options_.validate(name, value)};
+        if (!setting)
         {
-            boost::algorithm::trim(line);
-            if (line.empty())
+            return false;
+        }
+
+        asio::post(*context_,
+            [self = shared_from_this(), setting = std::move(*setting)]()
+            { self->apply_setting(setting); });
+        return true;
+    }
+
+    void configure(option_profile const& profile)
+    {
+        wait_until_ready();
+
+        asio::post(*context_,
+            [self = shared_from_this(),
+                settings = options_.resolve(profile)]()
             {
-                continue;
-            }
-            debug_output_.push_back(line);
+                for (option_setting const& setting : settings)
+                {
+                    self->apply_setting(setting);
+                }
+            });
 
-            std::string_view const view{line};
-            ast::uciok uciok; // NOLINT
-            if (phrase_parse(view.cbegin(),
-                    view.cend(),
-                    pawn::uciok(),
-                    space,
-                    uciok))
+        synchronize(false);
+    }
+
+    void synchronize(bool const new_game)
+    {
+        std::promise<void> ready;
+        auto ready_future{ready.get_future()};
+        synchronize(new_game, [&ready]() { ready.set_value(); });
+        ready_future.wait();
+    }
+
+    // A new game abandons the searches of the previous one, which has to be
+    // done on the reactor thread before ucinewgame is sent
+    void synchronize(bool const new_game, ready_callback callback)
+    {
+        asio::post(*context_,
+            [self = shared_from_this(),
+                callback = std::move(callback),
+                new_game]() mutable
             {
-                break;
+                if (self->end_of_output_)
+                {
+                    callback();
+                    return;
+                }
+
+                if (new_game)
+                {
+                    self->early_ponder_result_.reset();
+                    self->pending_search_.reset();
+                    if (self->searching_)
+                    {
+                        self->abandon_search();
+                    }
+                }
+
+                // The answer to isready completes the handshake while it's
+                // in progress
+                if (!self->handshake_completed_)
+                {
+                    self->queued_synchronizations_.push_back(
+                        {.new_game = new_game,
+                            .callback = std::move(callback)});
+                    return;
+                }
+
+                self->send_isready(new_game, std::move(callback));
+            });
+    }
+
+    [[nodiscard]] uci_options const& options() const
+    {
+        wait_until_ready();
+        return options_;
+    }
+
+    [[nodiscard]] std::string_view command_line() const
+    {
+        return command_line_;
+    }
+
+    void set_cache(analysis_cache* const cache) { cache_ = cache; }
+
+    template<typename Position>
+    void search(Position const& position,
+        search_limits const& limits,
+        search_callback callback)
+    {
+        std::optional<uint64_t> cache_key;
+        {
+            std::lock_guard const lock{position_mutex_};
+            position_.update(position);
+            if (cache_ && cacheable(limits))
+            {
+                cache_key =
+                    analysis_cache::key(configuration_, position_.command());
             }
         }
+
+        std::optional<cached_analysis> cached;
+        if (cache_key)
+        {
+            cached = cache_->find(*cache_key, *limits.depth);
+        }
+
+        asio::post(*context_,
+            [self = shared_from_this(),
+                search = queued_search{.limits = limits,
+                    .callback = std::move(callback),
+                    .cache_key = cache_key},
+                cached = std::move(cached)]() mutable
+            {
+                if (self->stopped_)
+                {
+                    return;
+                }
+                self->unclaimed_info_.reset();
+                self->early_ponder_result_.reset();
+
+                if (cached)
+                {
+                    // Replaces searches requested earlier as if the engine
+                    // had been asked
+                    self->pending_search_.reset();
+                    if (self->searching_)
+                    {
+                        self->abandon_search();
+                    }
+                    search.callback(cached_result(*std::move(cached)));
+                    return;
+                }
+
+                if (self->end_of_output_)
+                {
+                    search.callback(failed_search());
+                    return;
+                }
+
+                if (!self->handshake_completed_)
+                {
+                    self->pending_search_ = std::move(search);
+                    return;
+                }
+
+                if (self->searching_)
+                {
+                    self->abandon_search();
+                    self->pending_search_ = std::move(search);
+                    return;
+                }
+
+                self->start_search(std::move(search));
+            });
     }
 
-    impl(impl const&) = delete;
+    void ponderhit()
+    {
+        asio::post(*context_,
+            [self = shared_from_this()]()
+            {
+                // The move is available once the expected move is played
+                if (auto early{std::exchange(self->early_ponder_result_,
+                        std::nullopt)})
+                {
+                    early->result.received = std::chrono::steady_clock::now();
+                    early->callback(std::move(early->result));
+                }
+                else if (self->pondering_ && !self->pending_search_)
+                {
+                    self->pondering_ = false;
+                    self->active_limits_.ponder = false;
+                    self->expect_best_move(self->active_limits_);
+                    self->send_command("ponderhit");
+                }
+                else if (!self->handshake_completed_ && self->pending_search_)
+                {
+                    // The engine is restarting with the pondering search
+                    self->pending_search_->limits.ponder = false;
+                }
+            });
+    }
 
-    impl(impl&&) noexcept = delete;
+    void stop_search()
+    {
+        asio::post(*context_,
+            [self = shared_from_this()]()
+            {
+                self->early_ponder_result_.reset();
+                if (self->searching_ && !self->stopping_)
+                {
+                    if (self->pondering_)
+                    {
+                        self->abandon_search();
+                    }
+                    else
+                    {
+                        self->send_stop();
+                    }
+                }
+            });
+    }
+
+    [[nodiscard]] std::vector<search_sample> search_telemetry() const
+    {
+        std::lock_guard const lock{telemetry_mutex_};
+        return telemetry_;
+    }
+
+    [[nodiscard]] std::optional<search_sample> take_latest_info()
+    {
+        std::lock_guard const lock{latest_info_mutex_};
+        return std::exchange(latest_info_, std::nullopt);
+    }
+
+    void next_info(info_callback callback)
+    {
+        asio::post(*context_,
+            [self = shared_from_this(),
+                callback = std::move(callback)]() mutable
+            {
+                if (self->unclaimed_info_)
+                {
+                    callback(
+                        std::exchange(self->unclaimed_info_, std::nullopt));
+                    return;
+                }
+
+                self->end_info_updates();
+                if (self->search_callback_ || self->pending_search_)
+                {
+                    self->info_callback_ = std::move(callback);
+                }
+                else
+                {
+                    callback(std::nullopt);
+                }
+            });
+    }
+
+    [[nodiscard]] engine_health health() const
+    {
+        std::lock_guard const lock{health_mutex_};
+        return health_;
+    }
+
+    [[nodiscard]] std::optional<process_usage> resource_usage() const
+    {
+        int64_t pid; // NOLINT
+        {
+            std::lock_guard const lock{process_mutex_};
+            pid = pid_;
+        }
+
+        if (pid == 0)
+        {
+            return std::nullopt;
+        }
+        return sample_process(pid);
+    }
+
+    bool set_affinity(std::vector<uint32_t> cpus)
+    {
+        std::lock_guard const lock{process_mutex_};
+        affinity_ = std::move(cpus);
+        return pid_ != 0 && set_process_affinity(pid_, affinity_);
+    }
+
+    [[nodiscard]] engine_log& log() { return log_; }
 
 public:
-    ~impl()
+    impl& operator=(impl const&) = delete;
+
+    impl& operator=(impl&&) noexcept = delete;
+
+private:
+    struct [[nodiscard]] queued_search final
+    {
+        search_limits limits;
+        search_callback callback;
+        std::optional<uint64_t> cache_key;
+    };
+
+    struct [[nodiscard]] ready_request final
+    {
+        std::chrono::steady_clock::time_point sent;
+        // Empty for the pings of the watchdog
+        ready_callback waiter;
+    };
+
+    struct [[nodiscard]] queued_synchronization final
+    {
+        bool new_game;
+        ready_callback callback;
+    };
+
+    struct [[nodiscard]] early_result final
+    {
+        search_result result;
+        search_callback callback;
+    };
+
+private:
+    [[nodiscard]] static std::string setoption_command(
+        option_setting const& setting)
+    {
+        return setting.value.empty()
+            ? fmt::format("setoption name {}", setting.name)
+            : fmt::format("setoption name {} value {}",
+                  setting.name,
+                  setting.value);
+    }
+
+    template<typename Function>
+    void run_on_reactor(Function&& function)
+    {
+        if (context_->get_executor().running_in_this_thread())
+        {
+            function();
+            return;
+        }
+
+        std::promise<void> done;
+        asio::post(*context_,
+            [&function, &done]()
+            {
+                function();
+                done.set_value();
+            });
+        done.get_future().wait();
+    }
+
+    // Lines are views into the read buffer, valid until the next read
+    void read_output()
+    {
+        std::span<char> const space{read_buffer_.prepare()};
+        output_.async_read_some(asio::buffer(space.data(), space.size()),
+            [self = shared_from_this(), generation = generation_](
+                boost::system::error_code const& error,
+                size_t const bytes)
+            {
+                if (generation != self->generation_)
+                {
+                    return;
+                }
+
+                if (error)
+                {
+                    self->on_end_of_output();
+                    return;
+                }
+
+                self->read_buffer_.commit(bytes);
+                while (std::optional<std::string_view> const line{
+                    self->read_buffer_.next_line()})
+                {
+                    if (!line->empty())
+                    {
+                        if (self->recorder_)
+                        {
+                            self->recorder_->record(uci_direction::received,
+                                *line);
+                        }
+                        self->handle_line(*line);
+                    }
+
+                    if (generation != self->generation_)
+                    {
+                        return;
+                    }
+                }
+
+                self->read_output();
+            });
+    }
+
+    // Lines are classified by their first token and parsed once, by the
+    // handler of their message
+    void handle_line(std::string_view const line)
     {
-        using namespace std::chrono_literals;
+        uci_tokenizer arguments{line};
+        uci_message const message{classify(arguments)};
 
-        if (child_.running())
+        // Info lines and the answers to the watchdog are frequent, they are
+        // logged only during the handshake
+        if (!handshake_completed_ ||
+            (message != uci_message::info && message != uci_message::readyok))
         {
-            send_command("quit");
-            std::this_thread::sleep_for(10ms);
-            if (child_.running())
+            log_.push(line);
+        }
+
+        switch (message)
+        {
+        case uci_message::info:
+            handle_info(arguments);
+            break;
+        case uci_message::bestmove:
+            handle_bestmove(arguments);
+            break;
+        case uci_message::readyok:
+            handle_readyok();
+            break;
+        case uci_message::option:
+            handle_option(arguments);
+            break;
+        case uci_message::uciok:
+            handle_uciok();
+            break;
+        case uci_message::registration:
+            handle_registration(arguments);
+            break;
+        case uci_message::id:
+        case uci_message::copyprotection:
+        case uci_message::unknown:
+            break;
+        }
+    }
+
+    // Options declared before uciok are collected, the profile is applied
+    // and the handshake completes once the engine answers isready
+    // Options are collected once, a restarted engine declares the same ones
+    // and they are read from other threads after the first handshake
+    void handle_option(uci_tokenizer const arguments)
+    {
+        if (uciok_received_ || handshake_completed_ || handshake_signalled_)
+        {
+            return;
+        }
+
+        if (auto const option{parse_option(arguments)})
+        {
+            options_.add(to_option(*option));
+        }
+    }
+
+    void handle_uciok()
+    {
+        if (uciok_received_ || handshake_completed_)
+        {
+            return;
+        }
+
+        uciok_received_ = true;
+        for (option_setting const& setting : options_.resolve(profile_))
+        {
+            send_command(setoption_command(setting));
+        }
+        for (option_setting const& setting : applied_settings_)
+        {
+            send_command(setoption_command(setting));
+        }
+        send_command("isready");
+    }
+
+    void handle_readyok()
+    {
+        if (!handshake_completed_)
+        {
+            if (uciok_received_)
             {
-                std::this_thread::sleep_for(500ms);
-                child_.terminate();
+                complete_handshake();
             }
+            return;
+        }
+
+        if (ready_requests_.empty())
+        {
+            return;
+        }
+
+        ready_request request{std::move(ready_requests_.front())};
+        ready_requests_.pop_front();
+        {
+            std::lock_guard const lock{health_mutex_};
+            health_.isready_latency.record(
+                std::chrono::steady_clock::now() - request.sent);
+        }
+
+        if (request.waiter)
+        {
+            request.waiter();
         }
     }
 
-public:
-    [[nodiscard]] std::string next_move(std::span<std::string const> moves)
+    // Engines which require registration continue unregistered
+    void handle_registration(uci_tokenizer const arguments)
+    {
+        if (parse_status(arguments) == ast::status::error)
+        {
+            send_command("register later");
+        }
+    }
+
+    void handle_bestmove(uci_tokenizer const arguments)
+    {
+        if (!searching_)
+        {
+            return;
+        }
+
+        auto const bestmove{parse_bestmove(arguments)};
+        if (!bestmove)
+        {
+            return;
+        }
+
+        search_result result{.move = bestmove->move,
+            .ponder = bestmove->ponder,
+            .info = last_info_,
+            .received = std::chrono::steady_clock::now()};
+
+        // Engines aren't supposed to answer before ponderhit, the result is
+        // held until the expected move is played and dropped otherwise
+        if (pondering_ && search_callback_)
+        {
+            early_ponder_result_ = early_result{.result = result,
+                .callback = std::exchange(search_callback_, nullptr)};
+        }
+        complete_search(std::move(result));
+    }
+
+    void handle_info(uci_tokenizer const arguments)
+    {
+        if (!searching_ || !search_callback_)
+        {
+            return;
+        }
+
+        parse_info(arguments, info_);
+
+        // Lines of the other variations multiply the samples by the
+        // MultiPV setting without telling more about the search
+        if (info_.multipv > 1)
+        {
+            return;
+        }
+
+        auto const elapsed{std::chrono::steady_clock::now() - search_started_};
+        if (has_field(info_, ast::info_field::score))
+        {
+            last_info_ = info_;
+
+            if (info_callback_)
+            {
+                std::exchange(info_callback_, nullptr)(
+                    search_sample{elapsed, info_});
+            }
+            else
+            {
+                unclaimed_info_ = {elapsed, info_};
+            }
+
+            std::lock_guard const lock{latest_info_mutex_};
+            latest_info_ = {elapsed, info_};
+        }
+
+        // Infinite searches report until stopped, only the latest line is
+        // kept for them
+        if (!active_limits_.infinite)
+        {
+            std::lock_guard const lock{telemetry_mutex_};
+            telemetry_.push_back({elapsed, info_});
+        }
+    }
+
+    void start_search(queued_search search)
+    {
+        searching_ = true;
+        pondering_ = search.limits.ponder;
+        stopping_ = false;
+        search_callback_ = std::move(search.callback);
+        active_limits_ = search.limits;
+        active_cache_key_ = search.cache_key;
+        expect_best_move(active_limits_);
+        begin_search();
+
+        // Only the latest position is kept, a search which was queued for an
+        // older one is always abandoned by the search queued after it
+        {
+            std::lock_guard const lock{position_mutex_};
+            send_command(position_.command());
+        }
+
+        go_command_.clear();
+        append_go_command(go_command_, search.limits);
+        send_command(go_command_);
+    }
+
+    // Stops the current search without reporting its best move, used when
+    // the opponent didn't play the move the engine was pondering on
+    void abandon_search()
+    {
+        search_callback_ = nullptr;
+        end_info_updates();
+        if (!stopping_)
+        {
+            send_stop();
+        }
+    }
+
+    void send_stop()
+    {
+        stopping_ = true;
+
+        auto const deadline{
+            std::chrono::steady_clock::now() + watchdog_.timeout};
+        if (!best_move_deadline_ || deadline < *best_move_deadline_)
+        {
+            best_move_deadline_ = deadline;
+        }
+
+        send_command("stop");
+    }
+
+    // Settings applied after the handshake are sent again to restarted
+    // engines, the latest value of each option is kept
+    void apply_setting(option_setting const& setting)
+    {
+        if (uciok_received_)
+        {
+            send_command(setoption_command(setting));
+        }
+
+        auto const applied{std::ranges::find(applied_settings_,
+            setting.name,
+            &option_setting::name)};
+        if (applied == applied_settings_.end())
+        {
+            applied_settings_.push_back(setting);
+        }
+        else
+        {
+            *applied = setting;
+        }
+
+        std::lock_guard const lock{position_mutex_};
+        configuration_ =
+            cache_configuration(command_line_, profile_, applied_settings_);
+    }
+
+    void send_isready(bool const new_game, ready_callback callback)
+    {
+        if (new_game)
+        {
+            send_command("ucinewgame");
+        }
+
+        ready_requests_.push_back({.sent = std::chrono::steady_clock::now(),
+            .waiter = std::move(callback)});
+        send_command("isready");
+    }
+
+    void end_info_updates()
+    {
+        if (info_callback_)
+        {
+            std::exchange(info_callback_, nullptr)(std::nullopt);
+        }
+    }
+
+    void expect_best_move(search_limits const& limits)
+    {
+        best_move_deadline_.reset();
+        if (std::optional<std::chrono::milliseconds> const budget{
+                time_budget(limits)})
+        {
+            best_move_deadline_ = std::chrono::steady_clock::now() + *budget +
+                watchdog_.timeout;
+        }
+    }
+
+    void begin_search()
+    {
+        search_started_ = std::chrono::steady_clock::now();
+        last_info_ = {};
+
+        {
+            std::lock_guard const lock{latest_info_mutex_};
+            latest_info_.reset();
+        }
+
+        std::lock_guard const lock{telemetry_mutex_};
+        telemetry_.clear();
+    }
+
+    void on_end_of_output()
     {
-        using namespace std::chrono_literals;
-        using boost::spirit::x3::ascii::space;
+        if (!stopped_ && restarts_ < watchdog_.max_restarts)
+        {
+            restart();
+            return;
+        }
+
+        give_up();
+    }
+
+    void schedule_watchdog()
+    {
+        if (watchdog_.heartbeat == std::chrono::milliseconds{})
+        {
+            return;
+        }
+
+        watchdog_timer_.expires_after(watchdog_.heartbeat);
+        watchdog_timer_.async_wait(
+            [self = shared_from_this()](boost::system::error_code const& error)
+            {
+                if (error || self->stopped_ || self->end_of_output_)
+                {
+                    return;
+                }
+
+                self->check_engine();
+                if (!self->end_of_output_)
+                {
+                    self->schedule_watchdog();
+                }
+            });
+    }
 
-        send_command(
-            fmt::format("position startpos moves {}", fmt::join(moves, " ")));
+    // Restarts a stalled engine, otherwise pings it while it's idle
+    void check_engine()
+    {
         auto const now{std::chrono::steady_clock::now()};
-        send_command("go movetime 1000");
+        if (stalled(now))
+        {
+            {
+                std::lock_guard const lock{health_mutex_};
+                ++health_.stalls;
+            }
+
+            if (restarts_ < watchdog_.max_restarts)
+            {
+                restart();
+            }
+            else
+            {
+                give_up();
+            }
+            return;
+        }
 
-        std::string line;
-        while (std::getline(output_, line))
+        if (handshake_completed_ && !searching_ && ready_requests_.empty())
         {
-            boost::algorithm::trim(line);
-            if (line.empty() || line.starts_with("info"))
+            ready_requests_.push_back({.sent = now, .waiter = nullptr});
+            send_command("isready");
+        }
+    }
+
+    [[nodiscard]] bool stalled(
+        std::chrono::steady_clock::time_point const now) const
+    {
+        if (!handshake_completed_)
+        {
+            return now - spawned_ > watchdog_.timeout;
+        }
+
+        if (!ready_requests_.empty() &&
+            now - ready_requests_.front().sent > watchdog_.timeout)
+        {
+            return true;
+        }
+
+        return searching_ && best_move_deadline_ && now > *best_move_deadline_;
+    }
+
+    // Kills the engine and starts it again, the search in progress is
+    // started again from the current position after the handshake
+    void restart()
+    {
+        ++restarts_;
+        {
+            std::lock_guard const lock{health_mutex_};
+            ++health_.restarts;
+        }
+
+        close_engine();
+
+        if (searching_ && search_callback_ && !pending_search_)
+        {
+            pending_search_ = queued_search{.limits = active_limits_,
+                .callback = std::move(search_callback_),
+                .cache_key = active_cache_key_};
+        }
+        search_callback_ = nullptr;
+        searching_ = false;
+        pondering_ = false;
+        stopping_ = false;
+        best_move_deadline_.reset();
+
+        // Waiters are answered by the restarted engine, after its handshake
+        for (ready_request& request : std::exchange(ready_requests_, {}))
+        {
+            if (request.waiter)
             {
-                continue;
+                queued_synchronizations_.push_back(
+                    {.new_game = false, .callback = std::move(request.waiter)});
             }
-            debug_output_.push_back(line);
-
-            std::string_view const view{line};
-            ast::bestmove bestmove; // NOLINT
-            if (phrase_parse(view.cbegin(),
-                    view.cend(),
-                    pawn::bestmove(),
-                    space,
-                    bestmove))
-            {
-                std::this_thread::sleep_until(now + 1000ms);
-                return std::move(bestmove.move);
+        }
+
+        uciok_received_ = false;
+        handshake_completed_ = false;
+        read_buffer_.clear();
+        pending_output_.clear();
+        written_output_.clear();
+        writing_ = false;
+
+        try
+        {
+            input_ = bp::async_pipe{*context_};
+            output_ = bp::async_pipe{*context_};
+            child_ = bp::child{command_line_,
+                bp::std_out > output_,
+                bp::std_in < input_};
+
+            // Before the engine starts its search threads, which inherit
+            // the affinity
+            std::lock_guard const lock{process_mutex_};
+            pid_ = static_cast<int64_t>(child_.id());
+            if (!affinity_.empty())
+            {
+                static_cast<void>(set_process_affinity(pid_, affinity_));
             }
         }
+        catch (std::exception const&)
+        {
+            give_up();
+            return;
+        }
 
-        std::this_thread::sleep_until(now + 1000ms);
-        return "";
+        spawned_ = std::chrono::steady_clock::now();
+        read_output();
+        send_command("uci");
     }
 
-    [[nodiscard]] std::span<std::string const> debug_output() const
+    void give_up()
     {
-        auto data{debug_output_.array_one()};
-        return {data.first, data.second};
+        if (end_of_output_)
+        {
+            return;
+        }
+
+        close_engine();
+
+        end_of_output_ = true;
+        {
+            std::lock_guard const lock{health_mutex_};
+            health_.failed = true;
+        }
+        watchdog_timer_.cancel();
+        complete_handshake();
+        resolve_ready_requests();
+
+        if (stopped_)
+        {
+            exited_.set_value();
+            return;
+        }
+
+        auto pending{std::exchange(pending_search_, std::nullopt)};
+        complete_search(failed_search());
+        if (pending)
+        {
+            pending->callback(failed_search());
+        }
     }
 
-public:
-    impl& operator=(impl const&) = delete;
+    // Handlers of pending operations on the closed pipes are ignored
+    void close_engine()
+    {
+        ++generation_;
+        {
+            std::lock_guard const lock{process_mutex_};
+            pid_ = 0;
+        }
 
-    impl& operator=(impl&&) noexcept = delete;
+        boost::system::error_code ignored;
+        input_.close(ignored);
+        output_.close(ignored);
 
-private:
-    void send_command(std::string_view command)
+        std::error_code error;
+        if (child_.running(error))
+        {
+            child_.terminate(error);
+        }
+    }
+
+    void resolve_ready_requests()
+    {
+        for (ready_request& request : std::exchange(ready_requests_, {}))
+        {
+            if (request.waiter)
+            {
+                request.waiter();
+            }
+        }
+    }
+
+    void complete_handshake()
+    {
+        if (!handshake_completed_)
+        {
+            handshake_completed_ = true;
+            if (!handshake_signalled_)
+            {
+                handshake_signalled_ = true;
+                handshake_.set_value();
+            }
+
+            for (queued_synchronization& queued :
+                std::exchange(queued_synchronizations_, {}))
+            {
+                if (end_of_output_)
+                {
+                    queued.callback();
+                }
+                else
+                {
+                    send_isready(queued.new_game, std::move(queued.callback));
+                }
+            }
+
+            if (pending_search_ && !end_of_output_)
+            {
+                start_search(*std::exchange(pending_search_, std::nullopt));
+            }
+        }
+    }
+
+    void complete_search(search_result result)
+    {
+        cache_result(result);
+
+        searching_ = false;
+        pondering_ = false;
+        stopping_ = false;
+        best_move_deadline_.reset();
+
+        auto const callback{std::exchange(search_callback_, nullptr)};
+        end_info_updates();
+        if (pending_search_)
+        {
+            start_search(*std::exchange(pending_search_, std::nullopt));
+        }
+
+        if (callback)
+        {
+            callback(std::move(result));
+        }
+    }
+
+    // A search which wasn't stopped reached the requested depth even if the
+    // engine reported a shallower one, as it does after finding a mate
+    void cache_result(search_result const& result)
+    {
+        auto const key{std::exchange(active_cache_key_, std::nullopt)};
+        if (!key || !result.move || result.move->null())
+        {
+            return;
+        }
+
+        uint32_t depth{has_field(result.info, ast::info_field::depth)
+                ? result.info.depth
+                : 0};
+        if (!stopping_)
+        {
+            depth = std::max(depth, active_limits_.depth.value_or(0));
+        }
+
+        if (depth != 0)
+        {
+            cache_->store(*key,
+                {.move = *result.move,
+                    .ponder = result.ponder,
+                    .score = result.info.score.value,
+                    .mate = result.info.score.mate,
+                    .depth = depth,
+                    .nodes = result.info.nodes});
+        }
+    }
+
+    // Commands sent from the same handler are coalesced into a single write,
+    // the buffers are reused so no allocation is done once they've grown
+    void send_command(std::string_view const command)
+    {
+        if (end_of_output_ || stopped_)
+        {
+            return;
+        }
+
+        if (recorder_)
+        {
+            recorder_->record(uci_direction::sent, command);
+        }
+
+        pending_output_.append(command);
+        pending_output_.push_back('\n');
+        if (!writing_)
+        {
+            writing_ = true;
+            asio::post(*context_,
+                [self = shared_from_this(), generation = generation_]()
+                {
+                    if (generation == self->generation_)
+                    {
+                        self->write_pending();
+                    }
+                });
+        }
+    }
+
+    void write_pending()
     {
-        // NOLINTNEXTLINE(performance-avoid-endl)
-        input_ << command << std::endl;
+        if (pending_output_.empty() || end_of_output_)
+        {
+            writing_ = false;
+            return;
+        }
+
+        std::swap(pending_output_, written_output_);
+        asio::async_write(input_,
+            asio::buffer(written_output_),
+            [self = shared_from_this(), generation = generation_](
+                boost::system::error_code const& error,
+                [[maybe_unused]] size_t bytes)
+            {
+                if (generation != self->generation_)
+                {
+                    return;
+                }
+
+                self->written_output_.clear();
+                if (error)
+                {
+                    // The engine exited, the read handler may not have
+                    // noticed yet
+                    self->pending_output_.clear();
+                    self->writing_ = false;
+                    self->on_end_of_output();
+                    return;
+                }
+
+                self->write_pending();
+            });
     }
 
 private:
-    bp::opstream input_;
-    bp::ipstream output_;
+    asio::io_context* context_;
+
+    std::string command_line_;
+    bp::async_pipe input_;
+    bp::async_pipe output_;
     bp::child child_;
+    std::chrono::steady_clock::time_point spawned_;
+    // Incremented when the engine is closed
+    uint64_t generation_{};
+    std::promise<void> exited_;
 
-    boost::circular_buffer<std::string> debug_output_{50};
+    line_buffer read_buffer_;
+    std::string pending_output_;
+    std::string written_output_;
+    bool writing_{false};
+
+    watchdog_options watchdog_;
+    asio::steady_timer watchdog_timer_;
+    uint32_t restarts_{};
+    std::deque<ready_request> ready_requests_;
+    std::vector<queued_synchronization> queued_synchronizations_;
+    mutable std::mutex health_mutex_;
+    engine_health health_;
+
+    option_profile profile_;
+    std::vector<option_setting> applied_settings_;
+    std::promise<void> handshake_;
+    std::shared_future<void> handshake_completion_;
+    bool handshake_signalled_{false};
+    bool uciok_received_{false};
+    bool handshake_completed_{false};
+    bool end_of_output_{false};
+    bool stopped_{false};
+    uci_options options_;
+
+    bool searching_{false};
+    bool pondering_{false};
+    bool stopping_{false};
+    search_callback search_callback_;
+    search_limits active_limits_;
+    std::optional<uint64_t> active_cache_key_;
+    std::optional<std::chrono::steady_clock::time_point> best_move_deadline_;
+    std::optional<queued_search> pending_search_;
+    std::optional<early_result> early_ponder_result_;
+    std::mutex position_mutex_;
+    position_command position_;
+    std::string configuration_;
+    std::string go_command_;
+    std::chrono::steady_clock::time_point search_started_;
+
+    ast::info info_{};
+    ast::info last_info_{};
+    mutable std::mutex telemetry_mutex_;
+    std::vector<search_sample> telemetry_;
+    std::mutex latest_info_mutex_;
+    std::optional<search_sample> latest_info_;
+    info_callback info_callback_;
+    std::optional<search_sample> unclaimed_info_;
+
+    engine_log log_;
+    uci_recorder* recorder_;
+    analysis_cache* cache_{};
+
+    // Zero while no engine process is running
+    mutable std::mutex process_mutex_;
+    int64_t pid_;
+    std::vector<uint32_t> affinity_;
 };
 
-pawn::uci_engine::uci_engine(std::string_view command_line)
-    : impl_{std::make_unique<impl>(command_line)}
+pawn::uci_engine::uci_engine(std::string_view command_line,
+    uci_reactor& reactor,
+    option_profile const& profile,
+    watchdog_options const& watchdog,
+    uci_recorder* const recorder)
+    : impl_{std::make_shared<impl>(command_line,
+          profile,
+          watchdog,
+          recorder,
+          reactor.context())}
 {
+    impl_->start();
 }
 
 pawn::uci_engine::uci_engine(uci_engine&&) noexcept = default;
 
-pawn::uci_engine::~uci_engine() = default;
+pawn::uci_engine::~uci_engine()
+{
+    if (impl_)
+    {
+        impl_->shutdown();
+    }
+}
+
+bool pawn::uci_engine::set_option(std::string_view name,
+    std::string_view value)
+{
+    return impl_->set_option(name, value);
+}
+
+bool pawn::uci_engine::ready() const { return impl_->ready(); }
+
+void pawn::uci_engine::wait_until_ready() const { impl_->wait_until_ready(); }
+
+void pawn::uci_engine::configure(option_profile const& profile)
+{
+    impl_->configure(profile);
+}
+
+void pawn::uci_engine::synchronize() { impl_->synchronize(false); }
+
+void pawn::uci_engine::synchronize(ready_callback callback)
+{
+    impl_->synchronize(false, std::move(callback));
+}
 
-std::string pawn::uci_engine::next_move(std::span<std::string const> moves)
+void pawn::uci_engine::new_game() { impl_->synchronize(true); }
+
+void pawn::uci_engine::new_game(ready_callback callback)
+{
+    impl_->synchronize(true, std::move(callback));
+}
+
+std::string_view pawn::uci_engine::command_line() const
 {
-    return impl_->next_move(moves);
+    return impl_->command_line();
 }
 
-std::span<std::string const> pawn::uci_engine::debug_output() const
+pawn::uci_options const& pawn::uci_engine::options() const
 {
-    return impl_->debug_output();
+    return impl_->options();
+}
+
+void pawn::uci_engine::set_cache(analysis_cache* const cache)
+{
+    impl_->set_cache(cache);
+}
+
+void pawn::uci_engine::next_move(std::span<uci_move const> moves,
+    search_limits const& limits,
+    search_callback callback)
+{
+    search_limits search{limits};
+    search.ponder = false;
+    impl_->search(moves, search, std::move(callback));
+}
+
+void pawn::uci_engine::ponder(std::span<uci_move const> moves,
+    search_limits const& limits,
+    search_callback callback)
+{
+    search_limits search{limits};
+    search.ponder = true;
+    impl_->search(moves, search, std::move(callback));
+}
+
+void pawn::uci_engine::analyse(std::string_view fen,
+    search_limits const& limits,
+    search_callback callback)
+{
+    search_limits search{limits};
+    search.ponder = false;
+    impl_->search(fen, search, std::move(callback));
+}
+
+void pawn::uci_engine::ponderhit() { impl_->ponderhit(); }
+
+void pawn::uci_engine::stop() { impl_->stop_search(); }
+
+std::vector<pawn::search_sample> pawn::uci_engine::search_telemetry() const
+{
+    return impl_->search_telemetry();
+}
+
+std::optional<pawn::search_sample> pawn::uci_engine::take_latest_info()
+{
+    return impl_->take_latest_info();
+}
+
+void pawn::uci_engine::next_info(info_callback callback)
+{
+    impl_->next_info(std::move(callback));
+}
+
+pawn::engine_health pawn::uci_engine::health() const
+{
+    return impl_->health();
+}
+
+std::optional<pawn::process_usage> pawn::uci_engine::resource_usage() const
+{
+    return impl_->resource_usage();
+}
+
+bool pawn::uci_engine::set_affinity(std::vector<uint32_t> cpus)
+{
+    return impl_->set_affinity(std::move(cpus));
+}
+
+pawn::engine_log& pawn::uci_engine::log() { return impl_->log(); }
+
+pawn::uci_engine& pawn::uci_engine::operator=(uci_engine&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (impl_)
+        {
+            impl_->shutdown();
+        }
+        impl_ = std::move(other.impl_);
+    }
+    return *this;
 }
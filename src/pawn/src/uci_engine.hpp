@@ -1,17 +1,96 @@
 #ifndef PAWN_UCI_ENGINE_INCLUDED
 #define PAWN_UCI_ENGINE_INCLUDED
 
+#include <latency_histogram.hpp>
+#include <process_telemetry.hpp>
+#include <search_limits.hpp>
+#include <uci_ast.hpp>
+#include <uci_move.hpp>
+#include <uci_options.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    class analysis_cache;
+    class engine_log;
+    class uci_reactor;
+    class uci_recorder;
+} // namespace pawn
 
 namespace pawn
 {
+    struct [[nodiscard]] search_sample final
+    {
+        std::chrono::steady_clock::duration elapsed;
+        ast::info info;
+    };
+
+    struct [[nodiscard]] search_result final
+    {
+        // Empty if the engine failed, the null move if the position has no
+        // legal moves
+        std::optional<uci_move> move;
+        // The null move if the engine didn't propose one
+        uci_move ponder;
+        // Last scored info line of the principal variation
+        ast::info info;
+        // When the answer was read, before the callback is scheduled
+        std::chrono::steady_clock::time_point received;
+    };
+
+    struct [[nodiscard]] watchdog_options final
+    {
+        // Interval of isready pings while the engine is idle, zero disables
+        // the watchdog
+        std::chrono::milliseconds heartbeat{1000};
+        // Time allowed for uciok, readyok and for the best move after the
+        // time budget of the search elapses
+        std::chrono::milliseconds timeout{10000};
+        // Engines which stall or exit are started again at most this many
+        // times, afterwards searches complete without a move
+        uint32_t max_restarts{3};
+    };
+
+    struct [[nodiscard]] engine_health final
+    {
+        latency_histogram isready_latency;
+        uint32_t stalls{};
+        uint32_t restarts{};
+        // The engine is gone for good, searches complete without a move
+        bool failed{};
+    };
+
+    // Invoked on the reactor thread once the engine reports its best move.
+    using search_callback = std::function<void(search_result)>;
+
+    // Invoked on the reactor thread once the engine answers isready
+    using ready_callback = std::function<void()>;
+
+    // Invoked on the reactor thread with the next scored info line of the
+    // principal variation, empty once the search is over
+    using info_callback = std::function<void(std::optional<search_sample>)>;
+
     class [[nodiscard]] uci_engine final
     {
     public:
-        explicit uci_engine(std::string_view command_line);
+        // Doesn't wait for the handshake, the profile is applied during it.
+        // Searches requested before the engine is ready start once it is.
+        // The recorder, if any, receives the traffic until the engine is
+        // destroyed.
+        uci_engine(std::string_view command_line,
+            uci_reactor& reactor,
+            option_profile const& profile = {},
+            watchdog_options const& watchdog = {},
+            uci_recorder* recorder = nullptr);
 
         uci_engine(uci_engine const&) = delete;
 
@@ -21,9 +100,94 @@ namespace pawn
         ~uci_engine();
 
     public:
-        [[nodiscard]] std::string next_move(std::span<std::string const> moves);
+        [[nodiscard]] bool ready() const;
+
+        void wait_until_ready() const;
+
+        // Waits for the handshake, must not be called while the engine is
+        // searching.
+        // Returns false if the engine didn't declare the option or the value
+        // doesn't match its type.
+        [[nodiscard]] bool set_option(std::string_view name,
+            std::string_view value);
+
+        // Applies the profile and waits until the engine has processed it
+        void configure(option_profile const& profile);
+
+        // Waits for the engine to process the commands sent so far
+        void synchronize();
+
+        // Doesn't wait, also not for the handshake
+        void synchronize(ready_callback callback);
+
+        // Abandons the current search and sends ucinewgame, waits until the
+        // engine is ready for the first search of the game. Reusing a running
+        // engine this way skips the process start and the handshake.
+        void new_game();
+
+        // Doesn't wait, also not for the handshake
+        void new_game(ready_callback callback);
+
+        // Waits for the handshake
+        [[nodiscard]] uci_options const& options() const;
+
+        [[nodiscard]] std::string_view command_line() const;
+
+        // Searches limited only by depth are answered from the cache when it
+        // holds an analysis at least as deep, without involving the engine.
+        // Completed searches are stored. Must be set before searching.
+        void set_cache(analysis_cache* cache);
+
+        // Starting a search abandons the one in progress, its callback is
+        // not invoked
+        void next_move(std::span<uci_move const> moves,
+            search_limits const& limits,
+            search_callback callback);
+
+        // Searches the position after the expected reply, which is the last of
+        // the moves, while the opponent is thinking. The callback is invoked
+        // only if the search is converted with ponderhit, also if the engine
+        // reported its best move before.
+        void ponder(std::span<uci_move const> moves,
+            search_limits const& limits,
+            search_callback callback);
+
+        // Searches a position given in Forsyth-Edwards notation
+        void analyse(std::string_view fen,
+            search_limits const& limits,
+            search_callback callback);
+
+        void ponderhit();
+
+        void stop();
+
+        // Info lines of the principal variation received since the start of
+        // the current or last search, empty for infinite searches
+        [[nodiscard]] std::vector<search_sample> search_telemetry() const;
+
+        // Latest scored info line of the principal variation received since
+        // the previous call, earlier ones are dropped. Polled once per frame
+        // it costs the same however fast the engine reports.
+        [[nodiscard]] std::optional<search_sample> take_latest_info();
+
+        // Requests the next scored info line of the principal variation of
+        // the current search, lines arriving while no request is pending are
+        // coalesced to the latest. A new request completes the pending one
+        // empty. Independent of take_latest_info.
+        void next_info(info_callback callback);
+
+        [[nodiscard]] engine_health health() const;
+
+        // Samples the engine process, empty while it isn't running or if the
+        // platform doesn't expose the counters
+        [[nodiscard]] std::optional<process_usage> resource_usage() const;
+
+        // Pins the engine process and its threads to the CPUs, also after
+        // restarts. Returns false if the affinity couldn't be applied.
+        bool set_affinity(std::vector<uint32_t> cpus);
 
-        [[nodiscard]] std::span<std::string const> debug_output() const;
+        // Lines other than info, consumed by a single thread
+        [[nodiscard]] engine_log& log();
 
     public:
         uci_engine& operator=(uci_engine const&) = delete;
@@ -32,7 +196,7 @@ namespace pawn
 
     private:
         class impl;
-        std::unique_ptr<impl> impl_;
+        std::shared_ptr<impl> impl_;
     };
 } // namespace pawn
 
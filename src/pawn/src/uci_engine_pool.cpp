@@ -0,0 +1,107 @@
+#include <uci_engine_pool.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <utility>
+
+pawn::uci_engine_pool::uci_engine_pool(std::string_view command_line,
+    uci_reactor& reactor,
+    uci_engine_pool_options const& options)
+{
+    size_t const count{options.engines == 0
+            ? std::max<size_t>(std::thread::hardware_concurrency(), 1)
+            : options.engines};
+
+    engines_.reserve(count);
+    idle_.reserve(count);
+    for (size_t i{}; i != count; ++i)
+    {
+        engines_.emplace_back(command_line,
+            reactor,
+            options.profile,
+            options.watchdog);
+        engines_.back().set_cache(options.cache);
+        idle_.push_back(i);
+    }
+}
+
+pawn::uci_engine_pool::~uci_engine_pool()
+{
+    {
+        std::lock_guard const lock{mutex_};
+        queue_.clear();
+    }
+    engines_.clear();
+}
+
+size_t pawn::uci_engine_pool::size() const { return engines_.size(); }
+
+void pawn::uci_engine_pool::analyse(std::string fen,
+    search_limits const& limits,
+    search_callback callback)
+{
+    job work{.fen = std::move(fen),
+        .limits = limits,
+        .callback = std::move(callback)};
+
+    size_t engine; // NOLINT
+    {
+        std::lock_guard const lock{mutex_};
+        if (idle_.empty())
+        {
+            queue_.push_back(std::move(work));
+            return;
+        }
+
+        engine = idle_.back();
+        idle_.pop_back();
+    }
+
+    dispatch(engine, std::move(work));
+}
+
+std::future<pawn::search_result> pawn::uci_engine_pool::analyse(
+    std::string fen,
+    search_limits const& limits)
+{
+    auto promise{std::make_shared<std::promise<search_result>>()};
+    auto rv{promise->get_future()};
+
+    analyse(std::move(fen),
+        limits,
+        [promise = std::move(promise)](search_result result)
+        { promise->set_value(std::move(result)); });
+
+    return rv;
+}
+
+void pawn::uci_engine_pool::dispatch(size_t const engine, job work)
+{
+    engines_[engine].analyse(work.fen,
+        work.limits,
+        [this, engine, callback = std::move(work.callback)](
+            search_result result)
+        {
+            callback(std::move(result));
+            on_completed(engine);
+        });
+}
+
+void pawn::uci_engine_pool::on_completed(size_t const engine)
+{
+    job work;
+    {
+        std::lock_guard const lock{mutex_};
+        if (queue_.empty())
+        {
+            idle_.push_back(engine);
+            return;
+        }
+
+        work = std::move(queue_.front());
+        queue_.pop_front();
+    }
+
+    dispatch(engine, std::move(work));
+}
@@ -0,0 +1,85 @@
+#ifndef PAWN_UCI_ENGINE_POOL_INCLUDED
+#define PAWN_UCI_ENGINE_POOL_INCLUDED
+
+#include <search_limits.hpp>
+#include <uci_engine.hpp>
+#include <uci_options.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    class analysis_cache;
+    class uci_reactor;
+} // namespace pawn
+
+namespace pawn
+{
+    struct [[nodiscard]] uci_engine_pool_options final
+    {
+        // Zero uses one engine per hardware thread
+        size_t engines{};
+        option_profile profile{.threads = 1, .hash = 16};
+        watchdog_options watchdog{};
+        // Shared by the engines, must outlive the pool
+        analysis_cache* cache{};
+    };
+
+    class [[nodiscard]] uci_engine_pool final
+    {
+    public:
+        uci_engine_pool(std::string_view command_line,
+            uci_reactor& reactor,
+            uci_engine_pool_options const& options = {});
+
+        uci_engine_pool(uci_engine_pool const&) = delete;
+
+        uci_engine_pool(uci_engine_pool&&) noexcept = delete;
+
+    public:
+        ~uci_engine_pool();
+
+    public:
+        [[nodiscard]] size_t size() const;
+
+        // Callback is invoked on the reactor thread
+        void analyse(std::string fen,
+            search_limits const& limits,
+            search_callback callback);
+
+        [[nodiscard]] std::future<search_result> analyse(std::string fen,
+            search_limits const& limits);
+
+    public:
+        uci_engine_pool& operator=(uci_engine_pool const&) = delete;
+
+        uci_engine_pool& operator=(uci_engine_pool&&) noexcept = delete;
+
+    private:
+        struct [[nodiscard]] job final
+        {
+            std::string fen;
+            search_limits limits;
+            search_callback callback;
+        };
+
+        void dispatch(size_t engine, job work);
+
+        void on_completed(size_t engine);
+
+    private:
+        std::vector<uci_engine> engines_;
+
+        std::mutex mutex_;
+        std::deque<job> queue_;
+        std::vector<size_t> idle_;
+    };
+} // namespace pawn
+
+#endif
@@ -0,0 +1,109 @@
+#include <uci_engine_standby.hpp>
+
+#include <uci_engine.hpp>
+#include <uci_session.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+pawn::uci_engine_standby::uci_engine_standby(uci_reactor& reactor,
+    uci_engine_standby_options const& options)
+    : reactor_{&reactor}
+    , options_{options}
+{
+}
+
+pawn::uci_engine pawn::uci_engine_standby::acquire(
+    std::string_view const command_line)
+{
+    std::deque<uci_engine>& idle{idle_engines(command_line)};
+
+    std::optional<uci_engine> rv;
+    while (!rv && !idle.empty())
+    {
+        rv.emplace(std::move(idle.front()));
+        idle.pop_front();
+
+        // Idle engines may have exited since they were released
+        rv->new_game();
+        if (rv->health().failed)
+        {
+            rv.reset();
+        }
+    }
+
+    if (!rv)
+    {
+        rv.emplace(start(command_line));
+    }
+
+    fill_standby(command_line);
+    return *std::move(rv);
+}
+
+boost::asio::awaitable<pawn::uci_engine>
+pawn::uci_engine_standby::async_acquire(std::string const command_line)
+{
+    std::optional<uci_engine> rv;
+    while (!rv && !idle_engines(command_line).empty())
+    {
+        std::deque<uci_engine>& idle{idle_engines(command_line)};
+        rv.emplace(std::move(idle.front()));
+        idle.pop_front();
+
+        co_await uci_session{*rv}.new_game();
+        if (rv->health().failed)
+        {
+            rv.reset();
+        }
+    }
+
+    if (!rv)
+    {
+        rv.emplace(start(command_line));
+    }
+
+    fill_standby(command_line);
+    co_return *std::move(rv);
+}
+
+void pawn::uci_engine_standby::release(uci_engine engine)
+{
+    if (engine.health().failed)
+    {
+        return;
+    }
+
+    idle_engines(engine.command_line()).push_back(std::move(engine));
+}
+
+std::deque<pawn::uci_engine>& pawn::uci_engine_standby::idle_engines(
+    std::string_view const command_line)
+{
+    auto it{idle_.find(command_line)};
+    if (it == idle_.end())
+    {
+        it = idle_.emplace(std::string{command_line}, std::deque<uci_engine>{})
+                 .first;
+    }
+    return it->second;
+}
+
+pawn::uci_engine pawn::uci_engine_standby::start(
+    std::string_view const command_line)
+{
+    return {command_line, *reactor_, options_.profile, options_.watchdog};
+}
+
+void pawn::uci_engine_standby::fill_standby(std::string_view const command_line)
+{
+    std::deque<uci_engine>& idle{idle_engines(command_line)};
+    while (idle.size() < options_.standby)
+    {
+        idle.push_back(start(command_line));
+    }
+}
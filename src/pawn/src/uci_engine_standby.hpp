@@ -0,0 +1,80 @@
+#ifndef PAWN_UCI_ENGINE_STANDBY_INCLUDED
+#define PAWN_UCI_ENGINE_STANDBY_INCLUDED
+
+#include <uci_engine.hpp>
+#include <uci_options.hpp>
+
+#include <boost/asio/awaitable.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace pawn
+{
+    class uci_reactor;
+} // namespace pawn
+
+namespace pawn
+{
+    struct [[nodiscard]] uci_engine_standby_options final
+    {
+        option_profile profile{};
+        watchdog_options watchdog{};
+        // Engines of each command line started ahead of time, so that their
+        // process start and handshake overlap with the running game
+        size_t standby{};
+    };
+
+    // Keeps engine processes running between games. Not thread safe, meant to
+    // be owned by the thread or the coroutine which plays the games.
+    class [[nodiscard]] uci_engine_standby final
+    {
+    public:
+        explicit uci_engine_standby(uci_reactor& reactor,
+            uci_engine_standby_options const& options = {});
+
+        uci_engine_standby(uci_engine_standby const&) = delete;
+
+        uci_engine_standby(uci_engine_standby&&) noexcept = delete;
+
+    public:
+        ~uci_engine_standby() = default;
+
+    public:
+        // Reuses an idle engine of the command line after ucinewgame,
+        // otherwise starts a new one
+        [[nodiscard]] uci_engine acquire(std::string_view command_line);
+
+        // Same as acquire, waits for the reused engine without blocking the
+        // thread
+        [[nodiscard]] boost::asio::awaitable<uci_engine> async_acquire(
+            std::string command_line);
+
+        // Engines which failed are closed instead of being kept
+        void release(uci_engine engine);
+
+    public:
+        uci_engine_standby& operator=(uci_engine_standby const&) = delete;
+
+        uci_engine_standby& operator=(uci_engine_standby&&) noexcept = delete;
+
+    private:
+        [[nodiscard]] std::deque<uci_engine>& idle_engines(
+            std::string_view command_line);
+
+        [[nodiscard]] uci_engine start(std::string_view command_line);
+
+        void fill_standby(std::string_view command_line);
+
+    private:
+        uci_reactor* reactor_;
+        uci_engine_standby_options options_;
+        std::map<std::string, std::deque<uci_engine>, std::less<>> idle_;
+    };
+} // namespace pawn
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef PAWN_UCI_MOVE_INCLUDED
+#define PAWN_UCI_MOVE_INCLUDED
+
+#include <chess.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace pawn
+{
+    // Move in long algebraic notation packed into 16 bits, the squares take
+    // six bits each and are numbered from a1 to h8 rank by rank, followed by
+    // three bits of the promotion piece. Default constructed it is the null
+    // move 0000.
+    class [[nodiscard]] uci_move final
+    {
+    public:
+        // Length of the notation of promotions
+        static constexpr size_t max_length{5};
+
+    public:
+        constexpr uci_move() = default;
+
+        constexpr uci_move(uint8_t const from,
+            uint8_t const to,
+            piece_type const promotion = piece_type::none)
+            : value_{static_cast<uint16_t>((from & square_mask) |
+                  ((to & square_mask) << to_shift) |
+                  (promotion_bits(promotion) << promotion_shift))}
+        {
+        }
+
+        constexpr uci_move(uci_move const&) = default;
+
+        constexpr uci_move(uci_move&&) noexcept = default;
+
+    public:
+        constexpr ~uci_move() = default;
+
+    public:
+        [[nodiscard]] constexpr uint8_t from() const
+        {
+            return static_cast<uint8_t>(value_ & square_mask);
+        }
+
+        [[nodiscard]] constexpr uint8_t to() const
+        {
+            return static_cast<uint8_t>((value_ >> to_shift) & square_mask);
+        }
+
+        [[nodiscard]] constexpr piece_type promotion() const
+        {
+            switch (value_ >> promotion_shift)
+            {
+            case 1:
+                return piece_type::knight;
+            case 2:
+                return piece_type::bishop;
+            case 3:
+                return piece_type::rook;
+            case 4:
+                return piece_type::queen;
+            default:
+                return piece_type::none;
+            }
+        }
+
+        [[nodiscard]] constexpr bool null() const { return value_ == 0; }
+
+        // Writes the notation without a terminating zero, returns the end of
+        // the written characters. There must be room for max_length.
+        constexpr char* to_chars(char* out) const
+        {
+            if (null())
+            {
+                for (char const c : std::string_view{"0000"})
+                {
+                    *out++ = c;
+                }
+                return out;
+            }
+
+            *out++ = static_cast<char>('a' + from() % 8);
+            *out++ = static_cast<char>('1' + from() / 8);
+            *out++ = static_cast<char>('a' + to() % 8);
+            *out++ = static_cast<char>('1' + to() / 8);
+            if (uint16_t const promotion{
+                    static_cast<uint16_t>(value_ >> promotion_shift)};
+                promotion != 0)
+            {
+                *out++ = std::string_view{" nbrq"}[promotion];
+            }
+            return out;
+        }
+
+        [[nodiscard]] std::string to_string() const
+        {
+            std::string rv(max_length, '\0');
+            rv.resize(static_cast<size_t>(to_chars(rv.data()) - rv.data()));
+            return rv;
+        }
+
+    public:
+        constexpr uci_move& operator=(uci_move const&) = default;
+
+        constexpr uci_move& operator=(uci_move&&) noexcept = default;
+
+        constexpr bool operator==(uci_move const&) const = default;
+
+    private:
+        static constexpr uint16_t square_mask{0x3F};
+        static constexpr int to_shift{6};
+        static constexpr int promotion_shift{12};
+
+        [[nodiscard]] static constexpr uint16_t promotion_bits(
+            piece_type const promotion)
+        {
+            switch (promotion)
+            {
+            case piece_type::knight:
+                return 1;
+            case piece_type::bishop:
+                return 2;
+            case piece_type::rook:
+                return 3;
+            case piece_type::queen:
+                return 4;
+            default:
+                return 0;
+            }
+        }
+
+        uint16_t value_{};
+    };
+
+    static_assert(sizeof(uci_move) == 2);
+
+    // Accepts e2e4, e7e8q and the null move 0000
+    [[nodiscard]] constexpr std::optional<uci_move> parse_move(
+        std::string_view const notation)
+    {
+        if (notation == "0000")
+        {
+            return uci_move{};
+        }
+
+        if (notation.size() != 4 && notation.size() != uci_move::max_length)
+        {
+            return std::nullopt;
+        }
+
+        auto const square = [](char const file, char const rank)
+            -> std::optional<uint8_t>
+        {
+            if (file < 'a' || file > 'h' || rank < '1' || rank > '8')
+            {
+                return std::nullopt;
+            }
+            return static_cast<uint8_t>((rank - '1') * 8 + (file - 'a'));
+        };
+
+        std::optional<uint8_t> const from{square(notation[0], notation[1])};
+        std::optional<uint8_t> const to{square(notation[2], notation[3])};
+        if (!from || !to)
+        {
+            return std::nullopt;
+        }
+
+        piece_type promotion{piece_type::none};
+        if (notation.size() == uci_move::max_length)
+        {
+            switch (notation[4])
+            {
+            case 'n':
+                promotion = piece_type::knight;
+                break;
+            case 'b':
+                promotion = piece_type::bishop;
+                break;
+            case 'r':
+                promotion = piece_type::rook;
+                break;
+            case 'q':
+                promotion = piece_type::queen;
+                break;
+            default:
+                return std::nullopt;
+            }
+        }
+
+        return uci_move{*from, *to, promotion};
+    }
+} // namespace pawn
+
+#endif
@@ -0,0 +1,163 @@
+#include <uci_options.hpp>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    [[nodiscard]] std::optional<std::string> validate_value(
+        pawn::ast::option const& option,
+        std::string_view const value)
+    {
+        switch (option.type)
+        {
+        case pawn::ast::option_type::check:
+            if (boost::algorithm::iequals(value, "true"))
+            {
+                return "true";
+            }
+            if (boost::algorithm::iequals(value, "false"))
+            {
+                return "false";
+            }
+            return std::nullopt;
+        case pawn::ast::option_type::spin:
+        {
+            int64_t number; // NOLINT
+            auto const [end, error]{std::from_chars(value.data(),
+                value.data() + value.size(),
+                number)};
+            if (error != std::errc{} || end != value.data() + value.size())
+            {
+                return std::nullopt;
+            }
+
+            if (option.min_max)
+            {
+                number = std::clamp(number,
+                    option.min_max->first,
+                    option.min_max->second);
+            }
+            return fmt::to_string(number);
+        }
+        case pawn::ast::option_type::combo:
+        {
+            auto const it{std::ranges::find_if(option.values,
+                [value](std::string const& var)
+                { return boost::algorithm::iequals(var, value); })};
+            if (it == option.values.cend())
+            {
+                return std::nullopt;
+            }
+            return *it;
+        }
+        case pawn::ast::option_type::button:
+            if (!value.empty())
+            {
+                return std::nullopt;
+            }
+            return std::string{};
+        case pawn::ast::option_type::string:
+            return std::string{value};
+        }
+
+        return std::nullopt;
+    }
+
+    template<typename T>
+    void resolve_setting(pawn::uci_options const& options,
+        std::vector<pawn::option_setting>& settings,
+        std::string_view const name,
+        std::optional<T> const& value)
+    {
+        if (!value)
+        {
+            return;
+        }
+
+        std::optional<pawn::option_setting> setting;
+        if constexpr (std::is_same_v<T, std::chrono::milliseconds>)
+        {
+            setting = options.validate(name, fmt::to_string(value->count()));
+        }
+        else
+        {
+            setting = options.validate(name, fmt::to_string(*value));
+        }
+
+        if (setting)
+        {
+            settings.push_back(*std::move(setting));
+        }
+    }
+} // namespace
+
+void pawn::uci_options::add(ast::option option)
+{
+    auto const it{std::ranges::find_if(options_,
+        [&option](ast::option const& declared)
+        { return boost::algorithm::iequals(declared.name, option.name); })};
+    if (it != options_.cend())
+    {
+        *it = std::move(option);
+        return;
+    }
+
+    options_.push_back(std::move(option));
+}
+
+pawn::ast::option const* pawn::uci_options::find(
+    std::string_view const name) const
+{
+    auto const it{std::ranges::find_if(options_,
+        [name](ast::option const& option)
+        { return boost::algorithm::iequals(option.name, name); })};
+    return it == options_.cend() ? nullptr : &*it;
+}
+
+std::optional<pawn::option_setting> pawn::uci_options::validate(
+    std::string_view const name,
+    std::string_view const value) const
+{
+    ast::option const* const option{find(name)};
+    if (!option)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<std::string> valid{validate_value(*option, value)};
+    if (!valid)
+    {
+        return std::nullopt;
+    }
+
+    return option_setting{.name = option->name, .value = *std::move(valid)};
+}
+
+std::vector<pawn::option_setting> pawn::uci_options::resolve(
+    option_profile const& profile) const
+{
+    std::vector<option_setting> rv;
+    resolve_setting(*this, rv, "Threads", profile.threads);
+    resolve_setting(*this, rv, "Hash", profile.hash);
+    resolve_setting(*this, rv, "MultiPV", profile.multipv);
+    resolve_setting(*this, rv, "Move Overhead", profile.move_overhead);
+    return rv;
+}
+
+std::span<pawn::ast::option const> pawn::uci_options::options() const
+{
+    return options_;
+}
@@ -0,0 +1,74 @@
+#ifndef PAWN_UCI_OPTIONS_INCLUDED
+#define PAWN_UCI_OPTIONS_INCLUDED
+
+#include <uci_ast.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    // Options which aren't declared by the engine are skipped
+    struct [[nodiscard]] option_profile final
+    {
+        std::optional<uint32_t> threads{};
+        // Size of the hash table in megabytes
+        std::optional<uint32_t> hash{};
+        std::optional<uint32_t> multipv{};
+        std::optional<std::chrono::milliseconds> move_overhead{};
+    };
+
+    struct [[nodiscard]] option_setting final
+    {
+        std::string name;
+        std::string value;
+    };
+
+    // Options declared by the engine during the handshake
+    class [[nodiscard]] uci_options final
+    {
+    public:
+        uci_options() = default;
+
+        uci_options(uci_options const&) = default;
+
+        uci_options(uci_options&&) noexcept = default;
+
+    public:
+        ~uci_options() = default;
+
+    public:
+        // Replaces a previously declared option with the same name
+        void add(ast::option option);
+
+        // Option names are case insensitive
+        [[nodiscard]] ast::option const* find(std::string_view name) const;
+
+        // Returns the setting with the declared name of the option, spin
+        // values are clamped to the declared range. Empty if the option isn't
+        // declared or the value doesn't match its type.
+        [[nodiscard]] std::optional<option_setting> validate(
+            std::string_view name,
+            std::string_view value) const;
+
+        [[nodiscard]] std::vector<option_setting> resolve(
+            option_profile const& profile) const;
+
+        [[nodiscard]] std::span<ast::option const> options() const;
+
+    public:
+        uci_options& operator=(uci_options const&) = default;
+
+        uci_options& operator=(uci_options&&) noexcept = default;
+
+    private:
+        std::vector<ast::option> options_;
+    };
+} // namespace pawn
+
+#endif
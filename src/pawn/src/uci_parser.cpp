@@ -1,7 +1,10 @@
 #include <uci_parser.hpp>
 
+#include <uci_move.hpp>
+
 #include <boost/fusion/adapted/std_pair.hpp> // IWYU pragma: keep
 #include <boost/fusion/include/adapt_struct.hpp> // IWYU pragma: keep
+#include <boost/fusion/include/at_c.hpp>
 #include <boost/fusion/include/std_pair.hpp> // IWYU pragma: keep
 
 #include <string_view>
@@ -104,15 +107,169 @@ namespace pawn::parser
     BOOST_SPIRIT_INSTANTIATE(uciok_type, iterator_type, context_type)
 
     // bestmove g1f3
+    // bestmove (none)
     x3::rule<class bestmove, ast::bestmove> const bestmove{"bestmove"};
 
-    auto const bestmove_def = lit("bestmove") >> lexeme[+alnum] >>
-        -(lit("ponder") >> lexeme[+alnum]);
+    auto const bestmove_def = lit("bestmove") >>
+        lexeme[+(alnum | char_("()"))] >> -(lit("ponder") >> lexeme[+alnum]);
 
     BOOST_SPIRIT_DEFINE(bestmove)
 
     BOOST_SPIRIT_INSTANTIATE(bestmove_type, iterator_type, context_type)
 
+    // info depth 20 seldepth 27 multipv 1 score cp 31 nodes 1095340 nps 1032367
+    //   hashfull 417 tbhits 0 time 1061 pv e2e4 e7e5 g1f3 b8c6
+    // info depth 5 currmove e2e4 currmovenumber 1
+    // info string NNUE evaluation using nn-b1a57edbea57.nnue enabled
+    x3::rule<class info, ast::info> const info{"info"};
+
+    template<ast::info_field Field, auto Member>
+    struct set_field final
+    {
+        template<typename Context>
+        void operator()(Context const& ctx) const
+        {
+            ast::info& value{x3::_val(ctx)};
+            value.*Member = x3::_attr(ctx);
+            value.fields |= Field;
+        }
+    };
+
+    template<ast::info_field Field>
+    struct mark_field final
+    {
+        template<typename Context>
+        void operator()(Context const& ctx) const
+        {
+            x3::_val(ctx).fields |= Field;
+        }
+    };
+
+    // The move rule only matches valid notation
+    [[nodiscard]] uci_move to_move(auto const& range)
+    {
+        return parse_move(std::string_view{range.begin(), range.end()})
+            .value_or(uci_move{});
+    }
+
+    auto const set_cp = [](auto const& ctx)
+    {
+        ast::info& value{x3::_val(ctx)};
+        value.score.value = x3::_attr(ctx);
+        value.score.mate = false;
+        value.fields |= ast::info_field::score;
+    };
+
+    auto const set_mate = [](auto const& ctx)
+    {
+        ast::info& value{x3::_val(ctx)};
+        value.score.value = x3::_attr(ctx);
+        value.score.mate = true;
+        value.fields |= ast::info_field::score;
+    };
+
+    auto const set_lowerbound = [](auto const& ctx)
+    { x3::_val(ctx).score.lowerbound = true; };
+
+    auto const set_upperbound = [](auto const& ctx)
+    { x3::_val(ctx).score.upperbound = true; };
+
+    auto const set_currmove = [](auto const& ctx)
+    {
+        ast::info& value{x3::_val(ctx)};
+        value.currmove = to_move(x3::_attr(ctx));
+        value.fields |= ast::info_field::currmove;
+    };
+
+    auto const begin_pv = [](auto const& ctx)
+    {
+        ast::info& value{x3::_val(ctx)};
+        value.pv_length = 0;
+        value.fields |= ast::info_field::pv;
+    };
+
+    auto const push_pv = [](auto const& ctx)
+    {
+        ast::info& value{x3::_val(ctx)};
+        if (value.pv_length < ast::info::max_pv_length)
+        {
+            value.pv[value.pv_length++] = to_move(x3::_attr(ctx));
+        }
+    };
+
+    auto const set_wdl = [](auto const& ctx)
+    {
+        ast::info& value{x3::_val(ctx)};
+        auto const& attribute{x3::_attr(ctx)};
+        value.wdl = {boost::fusion::at_c<0>(attribute),
+            boost::fusion::at_c<1>(attribute),
+            boost::fusion::at_c<2>(attribute)};
+        value.fields |= ast::info_field::wdl;
+    };
+
+    auto const keyword = [](char const* const name)
+    { return lexeme[lit(name) >> !graph]; };
+
+    auto const move = x3::raw[lexeme[char_('a', 'h') >> char_('1', '8') >>
+                                  char_('a', 'h') >> char_('1', '8') >>
+                                  -char_("nbrq")] |
+        lexeme[lit("0000")]];
+
+    auto const info_score_def = keyword("score") >>
+        ((keyword("cp") >> x3::int32[set_cp]) |
+            (keyword("mate") >> x3::int32[set_mate])) >>
+        -(keyword("lowerbound")[set_lowerbound] |
+            keyword("upperbound")[set_upperbound]);
+
+    auto const info_item = (keyword("depth") >>
+                               x3::uint32[set_field<ast::info_field::depth,
+                                   &ast::info::depth>{}]) |
+        (keyword("seldepth") >>
+            x3::uint32[set_field<ast::info_field::seldepth,
+                &ast::info::seldepth>{}]) |
+        (keyword("multipv") >>
+            x3::uint32[set_field<ast::info_field::multipv,
+                &ast::info::multipv>{}]) |
+        info_score_def |
+        (keyword("time") >>
+            x3::uint64[set_field<ast::info_field::time, &ast::info::time>{}]) |
+        (keyword("nodes") >>
+            x3::uint64[set_field<ast::info_field::nodes,
+                &ast::info::nodes>{}]) |
+        (keyword("nps") >>
+            x3::uint64[set_field<ast::info_field::nps, &ast::info::nps>{}]) |
+        (keyword("tbhits") >>
+            x3::uint64[set_field<ast::info_field::tbhits,
+                &ast::info::tbhits>{}]) |
+        (keyword("sbhits") >>
+            x3::uint64[set_field<ast::info_field::sbhits,
+                &ast::info::sbhits>{}]) |
+        (keyword("hashfull") >>
+            x3::uint32[set_field<ast::info_field::hashfull,
+                &ast::info::hashfull>{}]) |
+        (keyword("cpuload") >>
+            x3::uint32[set_field<ast::info_field::cpuload,
+                &ast::info::cpuload>{}]) |
+        (keyword("currmovenumber") >>
+            x3::uint32[set_field<ast::info_field::currmovenumber,
+                &ast::info::currmovenumber>{}]) |
+        (keyword("currmove") >> move[set_currmove]) |
+        (keyword("wdl") >>
+            (x3::uint32 >> x3::uint32 >> x3::uint32)[set_wdl]) |
+        (keyword("pv")[begin_pv] >> +move[push_pv]) |
+        (keyword("refutation")[mark_field<ast::info_field::refutation>{}] >>
+            +move) |
+        (keyword("currline")[mark_field<ast::info_field::currline>{}] >>
+            -x3::uint32 >> +move) |
+        (keyword("string")[mark_field<ast::info_field::string_>{}] >>
+            lexeme[*char_]) |
+        lexeme[+graph];
+
+    auto const info_def = lit("info") >> x3::omit[*info_item];
+
+    BOOST_SPIRIT_DEFINE(info)
+
+    BOOST_SPIRIT_INSTANTIATE(info_type, iterator_type, context_type)
 } // namespace pawn::parser
 
 pawn::parser::id_type pawn::id() { return parser::id; }
@@ -122,3 +279,5 @@ pawn::parser::option_type pawn::option() { return parser::option; }
 pawn::parser::uciok_type pawn::uciok() { return parser::uciok; }
 
 pawn::parser::bestmove_type pawn::bestmove() { return parser::bestmove; }
+
+pawn::parser::info_type pawn::info() { return parser::info; }
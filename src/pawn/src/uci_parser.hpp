@@ -1,50 +1,11 @@
-#include <boost/optional/optional.hpp>
-#include <boost/spirit/home/x3.hpp>
-
-#include <cstdint>
-#include <string>
-#include <utility>
-#include <vector>
-
-// IWYU pragma: no_include <boost/preprocessor.hpp>
+#ifndef PAWN_UCI_PARSER_INCLUDED
+#define PAWN_UCI_PARSER_INCLUDED
 
-namespace pawn::ast
-{
-    struct [[nodiscard]] id final
-    {
-        std::string key;
-        std::string value;
-    };
+#include <uci_ast.hpp>
 
-    enum option_type : uint8_t
-    {
-        check,
-        spin,
-        combo,
-        button,
-        string
-    };
-
-    struct [[nodiscard]] option final
-    {
-        std::string name;
-        option_type type;
-        boost::optional<std::string> def;
-        boost::optional<std::pair<int64_t, int64_t>> min_max;
-        std::vector<std::string> values;
-    };
-
-    struct [[nodiscard]] uciok final
-    {
-        bool dummy;
-    };
+#include <boost/spirit/home/x3.hpp>
 
-    struct [[nodiscard]] bestmove final
-    {
-        std::string move;
-        std::string ponder;
-    };
-} // namespace pawn::ast
+// IWYU pragma: no_include <boost/preprocessor.hpp>
 
 namespace pawn
 {
@@ -64,6 +25,9 @@ namespace pawn
 
         using bestmove_type = x3::rule<class bestmove, ast::bestmove>;
         BOOST_SPIRIT_DECLARE(bestmove_type)
+
+        using info_type = x3::rule<class info, ast::info>;
+        BOOST_SPIRIT_DECLARE(info_type)
     } // namespace parser
 
     // NOLINTEND(bugprone-forward-declaration-namespace)
@@ -75,4 +39,8 @@ namespace pawn
     parser::uciok_type uciok();
 
     parser::bestmove_type bestmove();
+
+    parser::info_type info();
 } // namespace pawn
+
+#endif
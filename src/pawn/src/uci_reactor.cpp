@@ -0,0 +1,65 @@
+#include <uci_reactor.hpp>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <csignal>
+#include <thread>
+
+namespace asio = boost::asio;
+
+namespace
+{
+    // Writing to an engine which exited raises SIGPIPE, which terminates the
+    // process unless ignored. The write fails with broken_pipe instead.
+    void ignore_broken_pipes()
+    {
+#ifndef _WIN32
+        [[maybe_unused]] static auto const previous{
+            std::signal(SIGPIPE, SIG_IGN)};
+#endif
+    }
+} // namespace
+
+class [[nodiscard]] pawn::uci_reactor::impl final
+{
+public:
+    impl() : thread_{[this]() { context_.run(); }}
+    {
+        ignore_broken_pipes();
+    }
+
+    impl(impl const&) = delete;
+
+    impl(impl&&) noexcept = delete;
+
+public:
+    ~impl()
+    {
+        work_guard_.reset();
+        thread_.join();
+    }
+
+public:
+    [[nodiscard]] asio::io_context& context() { return context_; }
+
+public:
+    impl& operator=(impl const&) = delete;
+
+    impl& operator=(impl&&) noexcept = delete;
+
+private:
+    asio::io_context context_{1};
+    asio::executor_work_guard<asio::io_context::executor_type> work_guard_{
+        context_.get_executor()};
+    std::thread thread_;
+};
+
+pawn::uci_reactor::uci_reactor() : impl_{std::make_unique<impl>()} { }
+
+pawn::uci_reactor::~uci_reactor() = default;
+
+boost::asio::io_context& pawn::uci_reactor::context()
+{
+    return impl_->context();
+}
@@ -0,0 +1,39 @@
+#ifndef PAWN_UCI_REACTOR_INCLUDED
+#define PAWN_UCI_REACTOR_INCLUDED
+
+#include <memory>
+
+namespace boost::asio
+{
+    class io_context;
+} // namespace boost::asio
+
+namespace pawn
+{
+    class [[nodiscard]] uci_reactor final
+    {
+    public:
+        uci_reactor();
+
+        uci_reactor(uci_reactor const&) = delete;
+
+        uci_reactor(uci_reactor&&) noexcept = delete;
+
+    public:
+        ~uci_reactor();
+
+    public:
+        [[nodiscard]] boost::asio::io_context& context();
+
+    public:
+        uci_reactor& operator=(uci_reactor const&) = delete;
+
+        uci_reactor& operator=(uci_reactor&&) noexcept = delete;
+
+    private:
+        class impl;
+        std::unique_ptr<impl> impl_;
+    };
+} // namespace pawn
+
+#endif
@@ -0,0 +1,132 @@
+#include <uci_recording.hpp>
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::string_view magic{"PAWNUCI\x01", 8};
+
+    constexpr size_t flush_threshold{64 * 1024};
+
+    void append_varint(std::string& buffer, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    [[nodiscard]] std::optional<uint64_t> read_varint(std::string_view& bytes)
+    {
+        uint64_t rv{};
+        for (unsigned shift{}; shift < 64 && !bytes.empty(); shift += 7)
+        {
+            auto const byte{static_cast<uint8_t>(bytes.front())};
+            bytes.remove_prefix(1);
+
+            rv |= uint64_t{byte & 0x7FU} << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return rv;
+            }
+        }
+        return std::nullopt;
+    }
+} // namespace
+
+pawn::uci_recorder::uci_recorder(std::filesystem::path const& path)
+    : stream_{path, std::ios::binary | std::ios::trunc}
+    , started_{std::chrono::steady_clock::now()}
+{
+    if (!stream_)
+    {
+        throw std::runtime_error{
+            fmt::format("unable to open recording {}", path)};
+    }
+
+    buffer_.append(magic);
+}
+
+pawn::uci_recorder::~uci_recorder() { flush(); }
+
+void pawn::uci_recorder::record(uci_direction const direction,
+    std::string_view const line)
+{
+    auto const timestamp{std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started_)};
+
+    buffer_.push_back(static_cast<char>(direction));
+    append_varint(buffer_,
+        static_cast<uint64_t>((timestamp - last_timestamp_).count()));
+    append_varint(buffer_, line.size());
+    buffer_.append(line);
+    last_timestamp_ = timestamp;
+
+    if (buffer_.size() >= flush_threshold)
+    {
+        flush();
+    }
+}
+
+void pawn::uci_recorder::flush()
+{
+    stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    stream_.flush();
+    buffer_.clear();
+}
+
+std::optional<std::vector<pawn::uci_record>> pawn::read_recording(
+    std::filesystem::path const& path)
+{
+    std::ifstream stream{path, std::ios::binary};
+    if (!stream)
+    {
+        return std::nullopt;
+    }
+
+    std::string const bytes{std::istreambuf_iterator<char>{stream}, {}};
+    return parse_recording(bytes);
+}
+
+std::optional<std::vector<pawn::uci_record>> pawn::parse_recording(
+    std::string_view bytes)
+{
+    if (!bytes.starts_with(magic))
+    {
+        return std::nullopt;
+    }
+    bytes.remove_prefix(magic.size());
+
+    std::vector<uci_record> rv;
+    std::chrono::microseconds timestamp{};
+    while (!bytes.empty())
+    {
+        auto const direction{static_cast<uint8_t>(bytes.front())};
+        if (direction > static_cast<uint8_t>(uci_direction::received))
+        {
+            return std::nullopt;
+        }
+        bytes.remove_prefix(1);
+
+        std::optional<uint64_t> const delta{read_varint(bytes)};
+        std::optional<uint64_t> const length{read_varint(bytes)};
+        if (!delta || !length || *length > bytes.size())
+        {
+            break;
+        }
+
+        timestamp += std::chrono::microseconds{*delta};
+        rv.push_back({.direction = static_cast<uci_direction>(direction),
+            .timestamp = timestamp,
+            .line = std::string{bytes.substr(0, *length)}});
+        bytes.remove_prefix(*length);
+    }
+
+    return rv;
+}
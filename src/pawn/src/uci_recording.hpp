@@ -0,0 +1,71 @@
+#ifndef PAWN_UCI_RECORDING_INCLUDED
+#define PAWN_UCI_RECORDING_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    enum class uci_direction : uint8_t
+    {
+        sent,
+        received
+    };
+
+    struct [[nodiscard]] uci_record final
+    {
+        uci_direction direction{};
+        // Time since the start of the recording
+        std::chrono::microseconds timestamp{};
+        std::string line;
+    };
+
+    // Writes the traffic of an engine to a binary log. Each record is the
+    // direction, the varint encoded microseconds since the previous record,
+    // the varint encoded length and the line. Records are buffered and
+    // written in blocks, not thread safe.
+    class [[nodiscard]] uci_recorder final
+    {
+    public:
+        explicit uci_recorder(std::filesystem::path const& path);
+
+        uci_recorder(uci_recorder const&) = delete;
+
+        uci_recorder(uci_recorder&&) noexcept = delete;
+
+    public:
+        ~uci_recorder();
+
+    public:
+        void record(uci_direction direction, std::string_view line);
+
+        void flush();
+
+    public:
+        uci_recorder& operator=(uci_recorder const&) = delete;
+
+        uci_recorder& operator=(uci_recorder&&) noexcept = delete;
+
+    private:
+        std::ofstream stream_;
+        std::string buffer_;
+        std::chrono::steady_clock::time_point started_;
+        std::chrono::microseconds last_timestamp_{};
+    };
+
+    // A record truncated by an interrupted recording is dropped, empty if
+    // the file isn't a recording
+    [[nodiscard]] std::optional<std::vector<uci_record>> read_recording(
+        std::filesystem::path const& path);
+
+    [[nodiscard]] std::optional<std::vector<uci_record>> parse_recording(
+        std::string_view bytes);
+} // namespace pawn
+
+#endif
@@ -0,0 +1,62 @@
+#include <uci_replay.hpp>
+
+#include <optional>
+#include <utility>
+
+namespace
+{
+    [[nodiscard]] bool is_ping(pawn::uci_record const& record)
+    {
+        return record.line ==
+            (record.direction == pawn::uci_direction::sent ? "isready"
+                                                           : "readyok");
+    }
+} // namespace
+
+pawn::uci_replay::uci_replay(std::vector<uci_record> records)
+    : records_{std::move(records)}
+{
+    std::erase_if(records_, is_ping);
+}
+
+std::vector<pawn::uci_replay_line> pawn::uci_replay::start()
+{
+    return take_received({});
+}
+
+pawn::uci_replay_answer pawn::uci_replay::receive(
+    std::string_view const command)
+{
+    if (command == "isready")
+    {
+        return {.lines = {{.line = "readyok"}}, .expected = std::nullopt};
+    }
+
+    if (next_ == records_.size())
+    {
+        return {};
+    }
+
+    uci_record const& expected{records_[next_++]};
+    uci_replay_answer rv{.lines = take_received(expected.timestamp),
+        .expected = std::nullopt};
+    if (expected.line != command)
+    {
+        rv.expected = expected.line;
+    }
+    return rv;
+}
+
+std::vector<pawn::uci_replay_line> pawn::uci_replay::take_received(
+    std::chrono::microseconds const sent)
+{
+    std::vector<uci_replay_line> rv;
+    for (; next_ != records_.size() &&
+         records_[next_].direction == uci_direction::received;
+         ++next_)
+    {
+        uci_record const& record{records_[next_]};
+        rv.push_back({.delay = record.timestamp - sent, .line = record.line});
+    }
+    return rv;
+}
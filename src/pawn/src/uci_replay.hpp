@@ -0,0 +1,67 @@
+#ifndef PAWN_UCI_REPLAY_INCLUDED
+#define PAWN_UCI_REPLAY_INCLUDED
+
+#include <uci_recording.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace pawn
+{
+    struct [[nodiscard]] uci_replay_line final
+    {
+        // Recorded time since the command was sent, or since the start of
+        // the recording for the lines sent before the first command
+        std::chrono::microseconds delay{};
+        std::string_view line;
+    };
+
+    struct [[nodiscard]] uci_replay_answer final
+    {
+        std::vector<uci_replay_line> lines;
+        // The recorded command if another one was received
+        std::optional<std::string_view> expected;
+    };
+
+    // Answers the commands of a session with the lines the engine sent after
+    // each command. Commands are matched by their order, isready is answered
+    // directly because pings depend on the timing of the session. Lines
+    // refer to the records of the replay.
+    class [[nodiscard]] uci_replay final
+    {
+    public:
+        explicit uci_replay(std::vector<uci_record> records);
+
+        uci_replay(uci_replay const&) = delete;
+
+        uci_replay(uci_replay&&) noexcept = delete;
+
+    public:
+        ~uci_replay() = default;
+
+    public:
+        // Lines the engine sent before the first command
+        [[nodiscard]] std::vector<uci_replay_line> start();
+
+        // Empty once the recording is exhausted
+        [[nodiscard]] uci_replay_answer receive(std::string_view command);
+
+    public:
+        uci_replay& operator=(uci_replay const&) = delete;
+
+        uci_replay& operator=(uci_replay&&) noexcept = delete;
+
+    private:
+        [[nodiscard]] std::vector<uci_replay_line> take_received(
+            std::chrono::microseconds sent);
+
+    private:
+        std::vector<uci_record> records_;
+        size_t next_{};
+    };
+} // namespace pawn
+
+#endif
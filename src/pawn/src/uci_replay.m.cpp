@@ -0,0 +1,100 @@
+#include <uci_recording.hpp>
+#include <uci_replay.hpp>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Stands in for the engine of a recorded session:
+//   uci_replay <recording> [--paced]
+// Lines the engine sent after each command are written once the same
+// command is received, immediately or with the recorded delays.
+
+namespace
+{
+    // Reads stdin with the same stdio stream the lines are written with
+    [[nodiscard]] bool read_line(std::string& line)
+    {
+        line.clear();
+        for (int c{std::getc(stdin)}; c != EOF; c = std::getc(stdin))
+        {
+            if (c == '\n')
+            {
+                return true;
+            }
+            line.push_back(static_cast<char>(c));
+        }
+        return !line.empty();
+    }
+
+    void write_lines(std::span<pawn::uci_replay_line const> const lines,
+        std::optional<std::chrono::steady_clock::time_point> const paced_from)
+    {
+        for (pawn::uci_replay_line const& line : lines)
+        {
+            if (paced_from)
+            {
+                std::this_thread::sleep_until(*paced_from + line.delay);
+            }
+            fmt::print(stdout, "{}\n", line.line);
+            std::fflush(stdout);
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool const paced{argc > 2 && std::string_view{argv[2]} == "--paced"};
+    std::optional<std::vector<pawn::uci_record>> records{
+        argc > 1 ? pawn::read_recording(argv[1]) : std::nullopt};
+    if (!records)
+    {
+        fmt::print(stderr, "usage: uci_replay <recording> [--paced]\n");
+        return EXIT_FAILURE;
+    }
+
+    auto const pacing{[paced]()
+        {
+            return paced ? std::optional{std::chrono::steady_clock::now()}
+                         : std::nullopt;
+        }};
+
+    pawn::uci_replay session{std::move(*records)};
+    write_lines(session.start(), pacing());
+
+    std::string line;
+    while (read_line(line))
+    {
+        if (line.ends_with('\r'))
+        {
+            line.pop_back();
+        }
+
+        auto const received{pacing()};
+        pawn::uci_replay_answer const answer{session.receive(line)};
+        if (answer.expected)
+        {
+            fmt::print(stderr,
+                "uci_replay: expected '{}', received '{}'\n",
+                *answer.expected,
+                line);
+        }
+        write_lines(answer.lines, received);
+
+        if (line == "quit")
+        {
+            break;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+#include <uci_session.hpp>
+
+#include <search_limits.hpp>
+#include <uci_engine.hpp>
+#include <uci_move.hpp>
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace asio = boost::asio;
+
+namespace
+{
+    // Callbacks of the engine are copyable and invoked on the reactor
+    // thread, the completion handler is resumed through its own executor
+    template<typename Handler>
+    [[nodiscard]] auto resume(Handler handler)
+    {
+        return [handler = std::make_shared<Handler>(std::move(handler))]<
+                   typename... Args>(Args... args)
+        {
+            auto const executor{asio::get_associated_executor(*handler)};
+            asio::post(executor,
+                [handler, ... args = std::move(args)]() mutable
+                { std::move(*handler)(std::move(args)...); });
+        };
+    }
+
+    // Awaits the callback passed to the initiation
+    template<typename Signature, typename Initiation>
+    [[nodiscard]] auto callback(Initiation&& initiation)
+    {
+        return asio::async_initiate<decltype(asio::use_awaitable), Signature>(
+            [&initiation](auto handler)
+            { initiation(resume(std::move(handler))); },
+            asio::use_awaitable);
+    }
+} // namespace
+
+pawn::uci_session::uci_session(uci_engine& engine) : engine_{&engine} { }
+
+asio::awaitable<void> pawn::uci_session::isready()
+{
+    co_await callback<void()>([this](ready_callback&& on_ready)
+        { engine_->synchronize(std::move(on_ready)); });
+}
+
+asio::awaitable<void> pawn::uci_session::new_game()
+{
+    co_await callback<void()>([this](ready_callback&& on_ready)
+        { engine_->new_game(std::move(on_ready)); });
+}
+
+asio::awaitable<pawn::search_result> pawn::uci_session::go(
+    std::span<uci_move const> const moves,
+    search_limits const limits)
+{
+    co_return co_await callback<void(search_result)>(
+        [this, moves, &limits](search_callback&& on_result)
+        { engine_->next_move(moves, limits, std::move(on_result)); });
+}
+
+asio::awaitable<pawn::search_result> pawn::uci_session::analyse(
+    std::string const fen,
+    search_limits const limits)
+{
+    co_return co_await callback<void(search_result)>(
+        [this, &fen, &limits](search_callback&& on_result)
+        { engine_->analyse(fen, limits, std::move(on_result)); });
+}
+
+asio::awaitable<std::optional<pawn::search_sample>>
+pawn::uci_session::next_info()
+{
+    co_return co_await callback<void(std::optional<search_sample>)>(
+        [this](info_callback&& on_info)
+        { engine_->next_info(std::move(on_info)); });
+}
+
+pawn::uci_engine& pawn::uci_session::engine() const { return *engine_; }
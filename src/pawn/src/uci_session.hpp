@@ -0,0 +1,68 @@
+#ifndef PAWN_UCI_SESSION_INCLUDED
+#define PAWN_UCI_SESSION_INCLUDED
+
+#include <search_limits.hpp>
+#include <uci_engine.hpp>
+#include <uci_move.hpp>
+
+#include <boost/asio/awaitable.hpp>
+
+#include <optional>
+#include <span>
+#include <string>
+
+namespace pawn
+{
+    // Awaitable conversation with an engine, for coroutines started with
+    // boost::asio::co_spawn. Coroutines are resumed through their own
+    // executor, never on the reactor thread, so a few threads running
+    // io_contexts drive any number of sessions without blocking.
+    //
+    // The coroutine awaiting a search must be the only one searching with
+    // the engine, a search abandoned by another never completes.
+    class [[nodiscard]] uci_session final
+    {
+    public:
+        explicit uci_session(uci_engine& engine);
+
+        uci_session(uci_session const&) = default;
+
+        uci_session(uci_session&&) noexcept = default;
+
+    public:
+        ~uci_session() = default;
+
+    public:
+        // Sends isready after the handshake, completes with readyok
+        [[nodiscard]] boost::asio::awaitable<void> isready();
+
+        [[nodiscard]] boost::asio::awaitable<void> new_game();
+
+        // The moves are copied once the search is awaited
+        [[nodiscard]] boost::asio::awaitable<search_result> go(
+            std::span<uci_move const> moves,
+            search_limits limits);
+
+        [[nodiscard]] boost::asio::awaitable<search_result> analyse(
+            std::string fen,
+            search_limits limits);
+
+        // Generates the scored info lines of the principal variation of
+        // the search in progress, coalesced while the coroutine is busy.
+        // Empty once the search is over.
+        [[nodiscard]] boost::asio::awaitable<std::optional<search_sample>>
+        next_info();
+
+        [[nodiscard]] uci_engine& engine() const;
+
+    public:
+        uci_session& operator=(uci_session const&) = default;
+
+        uci_session& operator=(uci_session&&) noexcept = default;
+
+    private:
+        uci_engine* engine_;
+    };
+} // namespace pawn
+
+#endif
@@ -0,0 +1,545 @@
+#include <uci_tokenizer.hpp>
+
+#include <text_parse.hpp>
+#include <text_scan.hpp>
+#include <uci_ast.hpp>
+#include <uci_move.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+    // Consumes the next token only if it is a move
+    [[nodiscard]] std::optional<pawn::uci_move> next_move(
+        pawn::uci_tokenizer& tokens)
+    {
+        pawn::uci_tokenizer lookahead{tokens};
+        std::optional<pawn::uci_move> const rv{
+            pawn::parse_move(lookahead.next())};
+        if (rv)
+        {
+            tokens = lookahead;
+        }
+        return rv;
+    }
+
+    // Consumes the next token only if it satisfies the predicate, scanning
+    // it once
+    template<typename Predicate>
+    [[nodiscard]] std::string_view next_if(pawn::uci_tokenizer& tokens,
+        Predicate&& predicate)
+    {
+        pawn::uci_tokenizer lookahead{tokens};
+        std::string_view const rv{lookahead.next()};
+        if (rv.empty() || !predicate(rv))
+        {
+            return {};
+        }
+        tokens = lookahead;
+        return rv;
+    }
+
+    // Sets the member if the next token is a number, otherwise the keyword
+    // is treated as an unknown item
+    template<pawn::ast::info_field Field, auto Member>
+    void parse_field(pawn::uci_tokenizer& tokens, pawn::ast::info& info)
+    {
+        using value_type = std::remove_cvref_t<decltype(info.*Member)>;
+
+        pawn::uci_tokenizer lookahead{tokens};
+        if (auto const value{pawn::parse_number<value_type>(lookahead.next())})
+        {
+            tokens = lookahead;
+            info.*Member = *value;
+            info.fields |= Field;
+        }
+    }
+
+    void parse_score(pawn::uci_tokenizer& tokens, pawn::ast::info& info)
+    {
+        pawn::uci_tokenizer lookahead{tokens};
+        std::string_view const kind{lookahead.next()};
+        if (kind != "cp" && kind != "mate")
+        {
+            return;
+        }
+
+        auto const value{pawn::parse_number<int32_t>(lookahead.next())};
+        if (!value)
+        {
+            return;
+        }
+        tokens = lookahead;
+
+        info.score.value = *value;
+        info.score.mate = kind == "mate";
+        info.fields |= pawn::ast::info_field::score;
+
+        std::string_view const bound{next_if(tokens,
+            [](std::string_view const token)
+            { return token == "lowerbound" || token == "upperbound"; })};
+        info.score.lowerbound = bound == "lowerbound";
+        info.score.upperbound = bound == "upperbound";
+    }
+
+    // Returns the number of moves which followed
+    template<typename Function>
+    size_t parse_moves(pawn::uci_tokenizer& tokens, Function&& on_move)
+    {
+        size_t rv{};
+        for (std::optional<pawn::uci_move> move{next_move(tokens)}; move;
+             move = next_move(tokens))
+        {
+            on_move(*move);
+            ++rv;
+        }
+        return rv;
+    }
+} // namespace
+
+std::string_view pawn::uci_tokenizer::next()
+{
+    char const* const last{rest_.data() + rest_.size()};
+    char const* const first{find_non_space(rest_.data(), last)};
+    char const* const end{find_space(first, last)};
+
+    rest_ = {end, last};
+    return {first, end};
+}
+
+std::string_view pawn::uci_tokenizer::rest() const
+{
+    char const* const first{
+        find_non_space(rest_.data(), rest_.data() + rest_.size())};
+
+    char const* last{rest_.data() + rest_.size()};
+    while (last != first && is_space(*(last - 1)))
+    {
+        --last;
+    }
+    return {first, last};
+}
+
+pawn::uci_message pawn::classify(uci_tokenizer& tokens)
+{
+    std::string_view const token{tokens.next()};
+    if (token.empty())
+    {
+        return uci_message::unknown;
+    }
+
+    // A single comparison for most lines, info and bestmove are the frequent
+    // ones
+    switch (token.front())
+    {
+    case 'i':
+        if (token == "info")
+        {
+            return uci_message::info;
+        }
+        if (token == "id")
+        {
+            return uci_message::id;
+        }
+        break;
+    case 'b':
+        if (token == "bestmove")
+        {
+            return uci_message::bestmove;
+        }
+        break;
+    case 'r':
+        if (token == "readyok")
+        {
+            return uci_message::readyok;
+        }
+        if (token == "registration")
+        {
+            return uci_message::registration;
+        }
+        break;
+    case 'o':
+        if (token == "option")
+        {
+            return uci_message::option;
+        }
+        break;
+    case 'u':
+        if (token == "uciok")
+        {
+            return uci_message::uciok;
+        }
+        break;
+    case 'c':
+        if (token == "copyprotection")
+        {
+            return uci_message::copyprotection;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return uci_message::unknown;
+}
+
+// id name Stockfish 16.1
+// id author the Stockfish developers (see AUTHORS file)
+std::optional<pawn::ast::id_view> pawn::parse_id(uci_tokenizer arguments)
+{
+    std::string_view const key{arguments.next()};
+    std::string_view const value{arguments.rest()};
+    if ((key != "name" && key != "author") || value.empty())
+    {
+        return std::nullopt;
+    }
+
+    return ast::id_view{.key = key, .value = value};
+}
+
+// option name Threads type spin default 1 min 1 max 1024
+// option name Style type combo default Normal var Solid var Normal var Risky
+std::optional<pawn::ast::option_view> pawn::parse_option(
+    uci_tokenizer arguments)
+{
+    if (arguments.next() != "name")
+    {
+        return std::nullopt;
+    }
+
+    // Names may contain spaces, they span until the type keyword
+    std::string_view const first{arguments.next()};
+    std::string_view last{first};
+    for (std::string_view token{arguments.next()}; token != "type";
+         token = arguments.next())
+    {
+        if (token.empty())
+        {
+            return std::nullopt;
+        }
+        last = token;
+    }
+
+    if (first.empty() || first == "type")
+    {
+        return std::nullopt;
+    }
+
+    ast::option_view rv{};
+    rv.name = {first.data(),
+        static_cast<size_t>(last.data() + last.size() - first.data())};
+
+    std::string_view const type{arguments.next()};
+    if (type == "check")
+    {
+        rv.type = ast::option_type::check;
+    }
+    else if (type == "spin")
+    {
+        rv.type = ast::option_type::spin;
+    }
+    else if (type == "combo")
+    {
+        rv.type = ast::option_type::combo;
+    }
+    else if (type == "button")
+    {
+        rv.type = ast::option_type::button;
+    }
+    else if (type == "string")
+    {
+        rv.type = ast::option_type::string;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+
+    for (std::string_view token{arguments.next()}; !token.empty();
+         token = arguments.next())
+    {
+        if (token == "default")
+        {
+            if (std::string_view const value{arguments.next()}; !value.empty())
+            {
+                rv.def = value;
+            }
+        }
+        else if (token == "min")
+        {
+            auto const min{parse_number<int64_t>(arguments.next())};
+            if (!min || arguments.next() != "max")
+            {
+                return std::nullopt;
+            }
+
+            auto const max{parse_number<int64_t>(arguments.next())};
+            if (!max)
+            {
+                return std::nullopt;
+            }
+            rv.min_max = std::pair{*min, *max};
+        }
+        else if (token == "var")
+        {
+            std::string_view const value{arguments.next()};
+            if (!value.empty() && rv.values_length < rv.values.size())
+            {
+                rv.values[rv.values_length++] = value;
+            }
+        }
+    }
+
+    return rv;
+}
+
+// bestmove g1f3 ponder d7d5
+// bestmove (none)
+std::optional<pawn::ast::packed_bestmove> pawn::parse_bestmove(
+    uci_tokenizer arguments)
+{
+    std::string_view const move{arguments.next()};
+    std::optional<uci_move> const parsed{
+        move == "(none)" ? uci_move{} : parse_move(move)};
+    if (!parsed)
+    {
+        return std::nullopt;
+    }
+
+    ast::packed_bestmove rv{.move = *parsed, .ponder = {}};
+    if (arguments.next() == "ponder")
+    {
+        rv.ponder = parse_move(arguments.next()).value_or(uci_move{});
+    }
+    return rv;
+}
+
+// copyprotection checking
+// registration error
+std::optional<pawn::ast::status> pawn::parse_status(uci_tokenizer arguments)
+{
+    std::string_view const status{arguments.next()};
+    if (status == "checking")
+    {
+        return ast::status::checking;
+    }
+
+    if (status == "ok")
+    {
+        return ast::status::ok;
+    }
+
+    if (status == "error")
+    {
+        return ast::status::error;
+    }
+
+    return std::nullopt;
+}
+
+// info depth 20 seldepth 27 multipv 1 score cp 31 nodes 1095340 nps 1032367
+//   hashfull 417 tbhits 0 time 1061 pv e2e4 e7e5 g1f3 b8c6
+// info depth 5 currmove e2e4 currmovenumber 1
+// info string NNUE evaluation using nn-b1a57edbea57.nnue enabled
+void pawn::parse_info(uci_tokenizer arguments, ast::info& info)
+{
+    using ast::info_field;
+
+    info = {};
+    for (std::string_view token{arguments.next()}; !token.empty();
+         token = arguments.next())
+    {
+        if (token == "depth")
+        {
+            parse_field<info_field::depth, &ast::info::depth>(arguments, info);
+        }
+        else if (token == "seldepth")
+        {
+            parse_field<info_field::seldepth, &ast::info::seldepth>(arguments,
+                info);
+        }
+        else if (token == "multipv")
+        {
+            parse_field<info_field::multipv, &ast::info::multipv>(arguments,
+                info);
+        }
+        else if (token == "score")
+        {
+            parse_score(arguments, info);
+        }
+        else if (token == "time")
+        {
+            parse_field<info_field::time, &ast::info::time>(arguments, info);
+        }
+        else if (token == "nodes")
+        {
+            parse_field<info_field::nodes, &ast::info::nodes>(arguments, info);
+        }
+        else if (token == "nps")
+        {
+            parse_field<info_field::nps, &ast::info::nps>(arguments, info);
+        }
+        else if (token == "tbhits")
+        {
+            parse_field<info_field::tbhits, &ast::info::tbhits>(arguments,
+                info);
+        }
+        else if (token == "sbhits")
+        {
+            parse_field<info_field::sbhits, &ast::info::sbhits>(arguments,
+                info);
+        }
+        else if (token == "hashfull")
+        {
+            parse_field<info_field::hashfull, &ast::info::hashfull>(arguments,
+                info);
+        }
+        else if (token == "cpuload")
+        {
+            parse_field<info_field::cpuload, &ast::info::cpuload>(arguments,
+                info);
+        }
+        else if (token == "currmovenumber")
+        {
+            parse_field<info_field::currmovenumber,
+                &ast::info::currmovenumber>(arguments, info);
+        }
+        else if (token == "currmove")
+        {
+            if (std::optional<uci_move> const move{next_move(arguments)})
+            {
+                info.currmove = *move;
+                info.fields |= info_field::currmove;
+            }
+        }
+        else if (token == "wdl")
+        {
+            uci_tokenizer wdl_tokens{arguments};
+            auto const win{parse_number<uint32_t>(wdl_tokens.next())};
+            auto const draw{parse_number<uint32_t>(wdl_tokens.next())};
+            auto const loss{parse_number<uint32_t>(wdl_tokens.next())};
+            if (win && draw && loss)
+            {
+                arguments = wdl_tokens;
+                info.wdl = {*win, *draw, *loss};
+                info.fields |= info_field::wdl;
+            }
+        }
+        else if (token == "pv")
+        {
+            info.pv_length = 0;
+            if (parse_moves(arguments,
+                    [&info](uci_move const move)
+                    {
+                        if (info.pv_length < ast::info::max_pv_length)
+                        {
+                            info.pv[info.pv_length++] = move;
+                        }
+                    }) != 0)
+            {
+                info.fields |= info_field::pv;
+            }
+        }
+        else if (token == "refutation")
+        {
+            if (parse_moves(arguments, [](uci_move) { }) != 0)
+            {
+                info.fields |= info_field::refutation;
+            }
+        }
+        else if (token == "currline")
+        {
+            static_cast<void>(next_if(arguments,
+                [](std::string_view const number)
+                { return parse_number<uint32_t>(number).has_value(); }));
+
+            if (parse_moves(arguments, [](uci_move) { }) != 0)
+            {
+                info.fields |= info_field::currline;
+            }
+        }
+        else if (token == "string")
+        {
+            info.fields |= info_field::string_;
+            break;
+        }
+    }
+}
+
+std::optional<pawn::ast::id_view> pawn::parse_id(std::string_view const line)
+{
+    uci_tokenizer tokens{line};
+    if (classify(tokens) != uci_message::id)
+    {
+        return std::nullopt;
+    }
+    return parse_id(tokens);
+}
+
+std::optional<pawn::ast::option_view> pawn::parse_option(
+    std::string_view const line)
+{
+    uci_tokenizer tokens{line};
+    if (classify(tokens) != uci_message::option)
+    {
+        return std::nullopt;
+    }
+    return parse_option(tokens);
+}
+
+std::optional<pawn::ast::packed_bestmove> pawn::parse_bestmove(
+    std::string_view const line)
+{
+    uci_tokenizer tokens{line};
+    if (classify(tokens) != uci_message::bestmove)
+    {
+        return std::nullopt;
+    }
+    return parse_bestmove(tokens);
+}
+
+bool pawn::parse_info(std::string_view const line, ast::info& info)
+{
+    uci_tokenizer tokens{line};
+    if (classify(tokens) != uci_message::info)
+    {
+        return false;
+    }
+
+    parse_info(tokens, info);
+    return true;
+}
+
+pawn::ast::option pawn::to_option(ast::option_view const& view)
+{
+    ast::option rv{.name = std::string{view.name},
+        .type = view.type,
+        .def = {},
+        .min_max = {},
+        .values = {}};
+
+    if (view.def)
+    {
+        rv.def = std::string{*view.def};
+    }
+
+    if (view.min_max)
+    {
+        rv.min_max = *view.min_max;
+    }
+
+    rv.values.reserve(view.values_length);
+    for (uint8_t i{}; i != view.values_length; ++i)
+    {
+        rv.values.emplace_back(view.values[i]);
+    }
+
+    return rv;
+}
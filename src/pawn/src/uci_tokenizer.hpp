@@ -0,0 +1,96 @@
+#ifndef PAWN_UCI_TOKENIZER_INCLUDED
+#define PAWN_UCI_TOKENIZER_INCLUDED
+
+#include <uci_ast.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace pawn
+{
+    // Splits a line into tokens separated by whitespace, without copying
+    class [[nodiscard]] uci_tokenizer final
+    {
+    public:
+        explicit constexpr uci_tokenizer(std::string_view const line)
+            : rest_{line}
+        {
+        }
+
+        uci_tokenizer(uci_tokenizer const&) = default;
+
+        uci_tokenizer(uci_tokenizer&&) noexcept = default;
+
+    public:
+        ~uci_tokenizer() = default;
+
+    public:
+        // Empty once the line is exhausted
+        [[nodiscard]] std::string_view next();
+
+        // Remainder of the line without surrounding whitespace
+        [[nodiscard]] std::string_view rest() const;
+
+    public:
+        uci_tokenizer& operator=(uci_tokenizer const&) = default;
+
+        uci_tokenizer& operator=(uci_tokenizer&&) noexcept = default;
+
+    private:
+        std::string_view rest_;
+    };
+
+    // Messages sent by the engine to the GUI
+    enum class uci_message : uint8_t
+    {
+        unknown,
+        id,
+        uciok,
+        readyok,
+        bestmove,
+        copyprotection,
+        registration,
+        info,
+        option
+    };
+
+    // Consumes the first token of a line, the tokenizer is left at the
+    // arguments of the message for the parser of its type. Each line is
+    // scanned once.
+    [[nodiscard]] uci_message classify(uci_tokenizer& tokens);
+
+    // Hand written counterparts of the rules in uci_parser.hpp, which only
+    // accept complete tokens. Views point into the line.
+    [[nodiscard]] std::optional<ast::id_view> parse_id(
+        uci_tokenizer arguments);
+
+    [[nodiscard]] std::optional<ast::option_view> parse_option(
+        uci_tokenizer arguments);
+
+    [[nodiscard]] std::optional<ast::packed_bestmove> parse_bestmove(
+        uci_tokenizer arguments);
+
+    // Arguments of copyprotection and registration
+    [[nodiscard]] std::optional<ast::status> parse_status(
+        uci_tokenizer arguments);
+
+    // Resets the info before filling in the items of the line, unknown
+    // items are skipped
+    void parse_info(uci_tokenizer arguments, ast::info& info);
+
+    // Parse whole lines, empty if the line is a different message
+    [[nodiscard]] std::optional<ast::id_view> parse_id(std::string_view line);
+
+    [[nodiscard]] std::optional<ast::option_view> parse_option(
+        std::string_view line);
+
+    [[nodiscard]] std::optional<ast::packed_bestmove> parse_bestmove(
+        std::string_view line);
+
+    [[nodiscard]] bool parse_info(std::string_view line, ast::info& info);
+
+    [[nodiscard]] ast::option to_option(ast::option_view const& view);
+} // namespace pawn
+
+#endif
@@ -0,0 +1,109 @@
+#include <analysis_cache.hpp>
+
+#include <uci_move.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ranges>
+#include <string_view>
+
+namespace
+{
+    [[nodiscard]] pawn::cached_analysis analysis(std::string_view const move,
+        uint32_t const depth)
+    {
+        return {.move = pawn::parse_move(move).value(),
+            .ponder = {},
+            .score = 0,
+            .mate = false,
+            .depth = depth,
+            .nodes = 0};
+    }
+} // namespace
+
+TEST_CASE("analysis_cache", "[analysis]")
+{
+    std::filesystem::path const path{
+        std::filesystem::temp_directory_path() / "pawn_analysis_cache.bin"};
+    std::filesystem::remove(path);
+
+    uint64_t const key{
+        pawn::analysis_cache::key("stockfish", "position startpos")};
+    CHECK(key !=
+        pawn::analysis_cache::key("stockfish", "position startpos moves e2e4"));
+    CHECK(key != pawn::analysis_cache::key("lc0", "position startpos"));
+    CHECK(key != pawn::analysis_cache::key("stockfis", "hposition startpos"));
+
+    {
+        pawn::analysis_cache cache{path, 100};
+        CHECK(cache.capacity() == 128);
+        CHECK(std::ranges::distance(std::filesystem::directory_iterator{
+                  path.parent_path()} |
+                  std::views::filter(
+                      [&path](std::filesystem::directory_entry const& entry)
+                      {
+                          return entry.path().string().starts_with(
+                              path.string() + ".");
+                      })) == 0);
+        CHECK_FALSE(cache.find(key, 1));
+
+        cache.store(key,
+            {.move = pawn::parse_move("e2e4").value(),
+                .ponder = pawn::parse_move("e7e5").value(),
+                .score = -35,
+                .mate = false,
+                .depth = 12,
+                .nodes = 123456});
+    }
+
+    SECTION("entries persist between runs")
+    {
+        pawn::analysis_cache const cache{path, 4096};
+        CHECK(cache.capacity() == 128);
+
+        std::optional<pawn::cached_analysis> const entry{cache.find(key, 12)};
+        REQUIRE(entry);
+        CHECK(entry->move.to_string() == "e2e4");
+        CHECK(entry->ponder.to_string() == "e7e5");
+        CHECK(entry->score == -35);
+        CHECK_FALSE(entry->mate);
+        CHECK(entry->depth == 12);
+        CHECK(entry->nodes == 123456);
+    }
+
+    SECTION("shallower entries don't satisfy deeper searches")
+    {
+        pawn::analysis_cache cache{path};
+        CHECK(cache.find(key, 10));
+        CHECK_FALSE(cache.find(key, 13));
+
+        cache.store(key, analysis("d2d4", 8));
+        CHECK(cache.find(key, 12)->move.to_string() == "e2e4");
+
+        cache.store(key, analysis("g1f3", 16));
+        CHECK(cache.find(key, 13)->move.to_string() == "g1f3");
+    }
+
+    SECTION("files which aren't caches are replaced")
+    {
+        std::filesystem::resize_file(path, 1000);
+
+        pawn::analysis_cache const cache{path, 16};
+        CHECK(cache.capacity() == 16);
+        CHECK_FALSE(cache.find(key, 1));
+    }
+
+    SECTION("colliding keys are probed")
+    {
+        pawn::analysis_cache cache{path};
+        for (uint64_t i{1}; i != 8; ++i)
+        {
+            cache.store(key + i * 128, analysis("a2a3", 4));
+        }
+        CHECK(cache.find(key, 12)->move.to_string() == "e2e4");
+        CHECK(cache.find(key + 7 * 128, 4)->move.to_string() == "a2a3");
+    }
+}
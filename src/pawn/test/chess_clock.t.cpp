@@ -0,0 +1,114 @@
+#include <chess_clock.hpp>
+
+#include <chess.hpp>
+#include <search_limits.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <optional>
+
+TEST_CASE("parse_time_control", "[clock]")
+{
+    using namespace std::chrono_literals;
+
+    SECTION("increment")
+    {
+        auto const control{pawn::parse_time_control("10+0.1")};
+        REQUIRE(control);
+        CHECK(control->base == 10s);
+        CHECK(control->increment == 100ms);
+        CHECK(control->moves_per_period == 0);
+    }
+
+    SECTION("moves per period")
+    {
+        auto const control{pawn::parse_time_control("40/120")};
+        REQUIRE(control);
+        CHECK(control->base == 120s);
+        CHECK(control->increment == 0ms);
+        CHECK(control->moves_per_period == 40);
+    }
+
+    SECTION("fractional base")
+    {
+        auto const control{pawn::parse_time_control("0.5+0.05")};
+        REQUIRE(control);
+        CHECK(control->base == 500ms);
+        CHECK(control->increment == 50ms);
+    }
+
+    SECTION("invalid")
+    {
+        CHECK_FALSE(pawn::parse_time_control(""));
+        CHECK_FALSE(pawn::parse_time_control("+1"));
+        CHECK_FALSE(pawn::parse_time_control("0+1"));
+        CHECK_FALSE(pawn::parse_time_control("10+a"));
+        CHECK_FALSE(pawn::parse_time_control("x/10"));
+    }
+}
+
+TEST_CASE("chess_clock", "[clock]")
+{
+    using namespace std::chrono_literals;
+
+    pawn::chess_clock::clock_type::time_point const now{};
+
+    SECTION("increment is added after the move")
+    {
+        pawn::chess_clock clock{{.base = 10s, .increment = 100ms}};
+
+        clock.start(pawn::piece_color::white, now);
+        CHECK(clock.remaining(pawn::piece_color::white, now + 1s) == 9s);
+        CHECK(clock.stop(now + 1s));
+        CHECK(clock.remaining(pawn::piece_color::white) == 9100ms);
+        CHECK(clock.remaining(pawn::piece_color::black) == 10s);
+
+        auto const limits{clock.limits(pawn::piece_color::black)};
+        CHECK(limits.wtime == 9100ms);
+        CHECK(limits.btime == 10s);
+        CHECK(limits.winc == 100ms);
+        CHECK(limits.binc == 100ms);
+        CHECK_FALSE(limits.movestogo);
+        CHECK(go_command(limits) ==
+            "go wtime 9100 btime 10000 winc 100 binc 100");
+        CHECK(pawn::time_budget(limits) == 10s);
+    }
+
+    SECTION("flag")
+    {
+        pawn::chess_clock clock{{.base = 1s, .increment = 100ms}};
+
+        clock.start(pawn::piece_color::black, now);
+        CHECK_FALSE(clock.stop(now + 1001ms));
+        CHECK(clock.flagged() == pawn::piece_color::black);
+    }
+
+    SECTION("moves per period")
+    {
+        pawn::chess_clock clock{{.base = 10s, .moves_per_period = 2}};
+
+        CHECK(clock.limits(pawn::piece_color::white).movestogo == 2);
+
+        clock.start(pawn::piece_color::white, now);
+        CHECK(clock.stop(now + 1s));
+        CHECK(clock.limits(pawn::piece_color::white).movestogo == 1);
+
+        clock.start(pawn::piece_color::white, now);
+        CHECK(clock.stop(now + 1s));
+        CHECK(clock.limits(pawn::piece_color::white).movestogo == 2);
+        CHECK(clock.remaining(pawn::piece_color::white) == 18s);
+    }
+}
+
+TEST_CASE("time_budget", "[clock]")
+{
+    using namespace std::chrono_literals;
+
+    CHECK(pawn::time_budget({.movetime = 1s}) == 1s);
+    CHECK(pawn::time_budget({.wtime = 5s, .btime = 7s}) == 7s);
+    CHECK_FALSE(pawn::time_budget({.wtime = 5s, .ponder = true}));
+    CHECK_FALSE(pawn::time_budget({.depth = 20}));
+    CHECK_FALSE(pawn::time_budget({.wtime = 5s, .infinite = true}));
+    CHECK(pawn::go_command({.infinite = true}) == "go infinite");
+}
@@ -0,0 +1,86 @@
+#include <engine_log.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <thread>
+
+TEST_CASE("engine_log", "[uci]")
+{
+    SECTION("history keeps the latest lines")
+    {
+        pawn::engine_log log{3};
+
+        CHECK(log.push("id name Stockfish"));
+        CHECK(log.push("uciok"));
+        CHECK(log.update() == 2);
+        REQUIRE(log.size() == 2);
+        CHECK(log.line(0) == "id name Stockfish");
+        CHECK(log.line(1) == "uciok");
+
+        CHECK(log.push("readyok"));
+        CHECK(log.push("bestmove e2e4"));
+        CHECK(log.push("bestmove d2d4"));
+        CHECK(log.update() == 3);
+        REQUIRE(log.size() == 4);
+        CHECK(log.line(0) == "uciok");
+        CHECK(log.line(3) == "bestmove d2d4");
+    }
+
+    SECTION("lines are dropped while the consumer falls behind")
+    {
+        pawn::engine_log log{2};
+
+        CHECK(log.push("a"));
+        CHECK(log.push("b"));
+        CHECK_FALSE(log.push("c"));
+        CHECK(log.dropped() == 1);
+
+        CHECK(log.update() == 2);
+        CHECK(log.push("d"));
+    }
+
+    SECTION("long lines are truncated")
+    {
+        pawn::engine_log log;
+
+        std::string const line(300, 'x');
+        CHECK(log.push(line));
+        log.update();
+        CHECK(log.line(0).size() == pawn::engine_log::max_line_length);
+    }
+
+    SECTION("concurrent producer")
+    {
+        pawn::engine_log log{16};
+        constexpr size_t lines{10000};
+
+        std::thread producer{[&log]()
+            {
+                for (size_t i{}; i != lines;)
+                {
+                    if (log.push(std::to_string(i)))
+                    {
+                        ++i;
+                    }
+                }
+            }};
+
+        size_t received{};
+        bool ordered{true};
+        while (received != lines)
+        {
+            size_t const count{log.update()};
+            for (size_t i{log.size() - count}; i != log.size(); ++i)
+            {
+                ordered = ordered && log.line(i) == std::to_string(received);
+                ++received;
+            }
+        }
+        producer.join();
+
+        CHECK(ordered);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef PAWN_TEST_ENGINE_SEARCH_INCLUDED
+#define PAWN_TEST_ENGINE_SEARCH_INCLUDED
+
+#include <search_limits.hpp>
+#include <uci_engine.hpp>
+#include <uci_move.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace pawn::test
+{
+    // The callback completes the future
+    [[nodiscard]] inline std::pair<search_callback, std::future<search_result>>
+    expect_result()
+    {
+        auto const result{std::make_shared<std::promise<search_result>>()};
+        return {[result](search_result searched)
+            { result->set_value(std::move(searched)); },
+            result->get_future()};
+    }
+
+    // Empty if the engine doesn't answer in time, instead of hanging
+    [[nodiscard]] inline std::optional<search_result> wait_for(
+        std::future<search_result>& answer)
+    {
+        if (answer.wait_for(std::chrono::seconds{10}) !=
+            std::future_status::ready)
+        {
+            return std::nullopt;
+        }
+        return answer.get();
+    }
+
+    [[nodiscard]] inline std::optional<search_result> search(
+        uci_engine& engine,
+        search_limits const& limits,
+        std::span<uci_move const> const moves = {})
+    {
+        auto [callback, answer]{expect_result()};
+        engine.next_move(moves, limits, std::move(callback));
+        return wait_for(answer);
+    }
+} // namespace pawn::test
+
+#endif
@@ -0,0 +1,41 @@
+#include <epd.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <optional>
+
+TEST_CASE("epd", "[analysis]")
+{
+    SECTION("record with operations")
+    {
+        std::optional<pawn::epd_position> const position{pawn::parse_epd(
+            "1k1r4/pp1b1R2/3q2pp/4p3/2B5/4Q3/PPP2B2/2K5 b - - bm Qd1+; "
+            "id \"BK.01\";")};
+        REQUIRE(position);
+        CHECK(position->fen ==
+            "1k1r4/pp1b1R2/3q2pp/4p3/2B5/4Q3/PPP2B2/2K5 b - - 0 1");
+        CHECK(position->best_moves == "Qd1+");
+        CHECK(position->id == "BK.01");
+    }
+
+    SECTION("fen with move counters")
+    {
+        std::optional<pawn::epd_position> const position{pawn::parse_epd(
+            "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1\r")};
+        REQUIRE(position);
+        CHECK(position->fen ==
+            "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+        CHECK(position->id.empty());
+        CHECK(position->best_moves.empty());
+    }
+
+    SECTION("other lines")
+    {
+        CHECK_FALSE(pawn::parse_epd(""));
+        CHECK_FALSE(pawn::parse_epd("   "));
+        CHECK_FALSE(pawn::parse_epd("# Bratko-Kopec"));
+        CHECK_FALSE(pawn::parse_epd("8/8/8/8 w - -"));
+        CHECK_FALSE(pawn::parse_epd("8/8/8/8/8/8/8/8 x - -"));
+        CHECK_FALSE(pawn::parse_epd("8/8/8/8/8/8/8/8 w -"));
+    }
+}
@@ -0,0 +1,50 @@
+#include <latency_histogram.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+
+TEST_CASE("latency_histogram", "[uci]")
+{
+    using namespace std::chrono_literals;
+
+    pawn::latency_histogram histogram;
+
+    SECTION("empty")
+    {
+        CHECK(histogram.count() == 0);
+        CHECK(histogram.mean() == 0us);
+        CHECK(histogram.percentile(99) == 0us);
+    }
+
+    SECTION("buckets")
+    {
+        histogram.record(0us);
+        histogram.record(1us);
+        histogram.record(3us);
+        histogram.record(1ms);
+
+        auto const buckets{histogram.buckets()};
+        CHECK(buckets[0] == 1);
+        CHECK(buckets[1] == 1);
+        CHECK(buckets[2] == 1);
+        CHECK(buckets[10] == 1);
+        CHECK(histogram.count() == 4);
+        CHECK(histogram.min() == 0us);
+        CHECK(histogram.max() == 1ms);
+        CHECK(histogram.mean() == 251us);
+    }
+
+    SECTION("percentile")
+    {
+        for (int i{}; i != 99; ++i)
+        {
+            histogram.record(100us);
+        }
+        histogram.record(20ms);
+
+        CHECK(histogram.percentile(50) == 128us);
+        CHECK(histogram.percentile(99) == 128us);
+        CHECK(histogram.percentile(100) == 20ms);
+    }
+}
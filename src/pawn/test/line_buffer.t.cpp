@@ -0,0 +1,68 @@
+#include <line_buffer.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    void write(pawn::line_buffer& buffer, std::string_view data)
+    {
+        while (!data.empty())
+        {
+            std::span<char> const space{buffer.prepare()};
+            size_t const bytes{std::min(space.size(), data.size())};
+            std::ranges::copy(data.substr(0, bytes), space.begin());
+            buffer.commit(bytes);
+            data.remove_prefix(bytes);
+        }
+    }
+} // namespace
+
+TEST_CASE("line_buffer", "[uci]")
+{
+    using namespace std::string_view_literals;
+
+    SECTION("lines split across reads")
+    {
+        pawn::line_buffer buffer{16};
+
+        write(buffer, "id name Stock"sv);
+        CHECK_FALSE(buffer.next_line());
+
+        write(buffer, "fish\r\n  uciok \nready"sv);
+        CHECK(buffer.next_line() == "id name Stockfish");
+        CHECK(buffer.next_line() == "uciok");
+        CHECK_FALSE(buffer.next_line());
+
+        write(buffer, "ok\n\n"sv);
+        CHECK(buffer.next_line() == "readyok");
+        CHECK(buffer.next_line() == "");
+        CHECK_FALSE(buffer.next_line());
+    }
+
+    SECTION("line longer than capacity")
+    {
+        pawn::line_buffer buffer{4};
+
+        std::string const line(100, 'x');
+        write(buffer, line + "\n");
+        CHECK(buffer.next_line() == line);
+        CHECK_FALSE(buffer.next_line());
+    }
+
+    SECTION("clear")
+    {
+        pawn::line_buffer buffer;
+
+        write(buffer, "bestmove e2e4\nbest"sv);
+        buffer.clear();
+        write(buffer, "uciok\n"sv);
+        CHECK(buffer.next_line() == "uciok");
+    }
+}
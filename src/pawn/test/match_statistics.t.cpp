@@ -0,0 +1,57 @@
+#include <match_statistics.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <optional>
+
+TEST_CASE("elo estimate", "[tournament]")
+{
+    CHECK_FALSE(pawn::estimate_elo({}));
+    CHECK_FALSE(pawn::estimate_elo({.wins = 10}));
+    CHECK_FALSE(pawn::estimate_elo({.draws = 10}));
+
+    std::optional<pawn::elo_estimate> const even{
+        pawn::estimate_elo({.wins = 30, .draws = 40, .losses = 30})};
+    REQUIRE(even);
+    CHECK(even->elo == Catch::Approx(0.0).margin(1e-9));
+    CHECK(even->margin == Catch::Approx(53.16).epsilon(0.001));
+
+    std::optional<pawn::elo_estimate> const stronger{
+        pawn::estimate_elo({.wins = 60, .draws = 30, .losses = 10})};
+    REQUIRE(stronger);
+    CHECK(stronger->elo == Catch::Approx(190.85).epsilon(0.001));
+
+    std::optional<pawn::elo_estimate> const lopsided{
+        pawn::estimate_elo({.wins = 1, .losses = 1})};
+    REQUIRE(lopsided);
+    CHECK(std::isinf(lopsided->margin));
+}
+
+TEST_CASE("sprt", "[tournament]")
+{
+    pawn::sprt_parameters const parameters{.elo0 = 0.0,
+        .elo1 = 10.0,
+        .alpha = 0.05,
+        .beta = 0.05};
+
+    pawn::sprt_status const empty{pawn::sprt({}, parameters)};
+    CHECK(empty.state == pawn::sprt_state::running);
+    CHECK(empty.lower_bound == Catch::Approx(-2.944).epsilon(0.001));
+    CHECK(empty.upper_bound == Catch::Approx(2.944).epsilon(0.001));
+
+    pawn::sprt_status const close{
+        pawn::sprt({.wins = 52, .draws = 100, .losses = 48}, parameters)};
+    CHECK(close.state == pawn::sprt_state::running);
+
+    pawn::sprt_status const better{
+        pawn::sprt({.wins = 700, .draws = 1000, .losses = 500}, parameters)};
+    CHECK(better.llr > better.upper_bound);
+    CHECK(better.state == pawn::sprt_state::accepted_h1);
+
+    pawn::sprt_status const worse{
+        pawn::sprt({.wins = 500, .draws = 1000, .losses = 600}, parameters)};
+    CHECK(worse.llr < worse.lower_bound);
+    CHECK(worse.state == pawn::sprt_state::accepted_h0);
+}
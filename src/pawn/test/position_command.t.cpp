@@ -0,0 +1,67 @@
+#include <position_command.hpp>
+
+#include <uci_move.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    [[nodiscard]] pawn::uci_move move(std::string_view const notation)
+    {
+        return pawn::parse_move(notation).value();
+    }
+} // namespace
+
+TEST_CASE("position_command", "[uci]")
+{
+    pawn::position_command command;
+
+    SECTION("starting position")
+    {
+        CHECK(command.update(std::vector<pawn::uci_move>{}) ==
+            "position startpos");
+    }
+
+    SECTION("appends new moves")
+    {
+        std::vector moves{move("e2e4")};
+        CHECK(command.update(moves) == "position startpos moves e2e4");
+
+        moves.push_back(move("e7e5"));
+        moves.push_back(move("g1f3"));
+        CHECK(command.update(moves) ==
+            "position startpos moves e2e4 e7e5 g1f3");
+        CHECK(command.command() == "position startpos moves e2e4 e7e5 g1f3");
+    }
+
+    SECTION("replaces diverging moves")
+    {
+        std::vector moves{move("e2e4"), move("e7e5"), move("g1f3")};
+        CHECK(command.update(moves) ==
+            "position startpos moves e2e4 e7e5 g1f3");
+
+        moves.back() = move("f1c4");
+        CHECK(command.update(moves) ==
+            "position startpos moves e2e4 e7e5 f1c4");
+
+        moves = {move("d2d4")};
+        CHECK(command.update(moves) == "position startpos moves d2d4");
+
+        moves.clear();
+        CHECK(command.update(moves) == "position startpos");
+    }
+
+    SECTION("fen")
+    {
+        std::vector const moves{move("e2e4")};
+        CHECK(command.update(moves) == "position startpos moves e2e4");
+
+        CHECK(command.update("8/8/8/8/8/8/8/K6k w - - 0 1") ==
+            "position fen 8/8/8/8/8/8/8/K6k w - - 0 1");
+
+        CHECK(command.update(moves) == "position startpos moves e2e4");
+    }
+}
@@ -0,0 +1,63 @@
+#include <process_telemetry.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+TEST_CASE("parse_proc_stat", "[telemetry]")
+{
+    using namespace std::chrono_literals;
+
+    std::optional<pawn::process_usage> const usage{pawn::parse_proc_stat(
+        "4242 (stock fish) S 1 4242 4242 0 -1 4194304 1290 0 0 0 250 30 0 0 "
+        "20 0 4 0 123 1048576 2048 18446744073709551615\n",
+        100)};
+    REQUIRE(usage);
+    CHECK(usage->user_time == 2500ms);
+    CHECK(usage->system_time == 300ms);
+    CHECK(usage->threads == 4);
+
+    CHECK_FALSE(pawn::parse_proc_stat("4242 (stockfish) S 1", 100));
+}
+
+TEST_CASE("parse_proc_status", "[telemetry]")
+{
+    pawn::process_usage usage;
+    pawn::parse_proc_status("Name:\tstockfish\n"
+                            "VmRSS:\t   51200 kB\n"
+                            "Threads:\t4\n"
+                            "voluntary_ctxt_switches:\t12\n"
+                            "nonvoluntary_ctxt_switches:\t3\n",
+        usage);
+    CHECK(usage.resident_bytes == 51200 * 1024);
+    CHECK(usage.voluntary_context_switches == 12);
+    CHECK(usage.involuntary_context_switches == 3);
+}
+
+TEST_CASE("parse_cpu_list", "[telemetry]")
+{
+    CHECK(pawn::parse_cpu_list("0-3,8,10-11\n") ==
+        std::vector<uint32_t>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(pawn::parse_cpu_list("5") == std::vector<uint32_t>{5});
+    CHECK_FALSE(pawn::parse_cpu_list(""));
+    CHECK_FALSE(pawn::parse_cpu_list("3-1"));
+    CHECK_FALSE(pawn::parse_cpu_list("0,x"));
+}
+
+#ifdef __linux__
+TEST_CASE("sample_process", "[telemetry]")
+{
+    std::optional<pawn::process_usage> const usage{
+        pawn::sample_process(getpid())};
+    REQUIRE(usage);
+    CHECK(usage->resident_bytes > 0);
+    CHECK(usage->threads >= 1);
+}
+#endif
@@ -0,0 +1,59 @@
+#include <text_scan.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <string>
+
+TEST_CASE("text_scan", "[uci]")
+{
+    pawn::scan_kernel const detected{pawn::selected_scan_kernel()};
+
+    // Every match position in strings of up to two AVX2 vectors and then
+    // some, covering the vector loops and the scalar tails, with bytes
+    // above 127 which are not whitespace
+    for (pawn::scan_kernel const kernel : {pawn::scan_kernel::scalar,
+             pawn::scan_kernel::sse2,
+             pawn::scan_kernel::avx2})
+    {
+        if (!pawn::select_scan_kernel(kernel))
+        {
+            continue;
+        }
+
+        for (size_t length{}; length != 70; ++length)
+        {
+            for (size_t position{}; position <= length; ++position)
+            {
+                std::string text(length, '\xE9');
+                std::string blank(length, '\t');
+                if (position != length)
+                {
+                    text[position] = "\n \t\v\f\r"[position % 6];
+                    blank[position] = '4';
+                }
+
+                char const* const first{text.data()};
+                char const* const last{first + length};
+                size_t const space{
+                    static_cast<size_t>(pawn::find_space(first, last) - first)};
+                CHECK(space == position);
+
+                size_t const newline{static_cast<size_t>(
+                    pawn::find_newline(first, last) - first)};
+                CHECK(newline ==
+                    (position % 6 == 0 || position == length ? position
+                                                             : length));
+
+                size_t const non_space{static_cast<size_t>(
+                    pawn::find_non_space(blank.data(),
+                        blank.data() + length) -
+                    blank.data())};
+                CHECK(non_space == position);
+            }
+        }
+    }
+
+    CHECK_FALSE(pawn::select_scan_kernel(static_cast<pawn::scan_kernel>(3)));
+    CHECK(pawn::select_scan_kernel(detected));
+}
@@ -0,0 +1,490 @@
+#include <uci_engine.hpp>
+
+#include <engine_search.hpp>
+#include <process_telemetry.hpp>
+#include <search_limits.hpp>
+#include <text_parse.hpp>
+#include <uci_move.hpp>
+#include <uci_reactor.hpp>
+#include <uci_recording.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    using pawn::test::expect_result;
+    using pawn::test::search;
+    using pawn::test::wait_for;
+
+    constexpr pawn::search_limits timed_search{
+        .movetime = std::chrono::milliseconds{20}};
+
+    constexpr pawn::watchdog_options watchdog{
+        .heartbeat = std::chrono::milliseconds{10},
+        .timeout = std::chrono::milliseconds{200},
+        .max_restarts = 1};
+
+    [[nodiscard]] std::vector<pawn::uci_move> line(
+        std::initializer_list<std::string_view> const moves)
+    {
+        std::vector<pawn::uci_move> rv;
+        for (std::string_view const move : moves)
+        {
+            rv.push_back(pawn::parse_move(move).value());
+        }
+        return rv;
+    }
+
+    // Only the first process started fails if a marker is given
+    [[nodiscard]] std::string failing_engine(std::string_view const failure,
+        std::filesystem::path const& marker = {})
+    {
+        return marker.empty()
+            ? fmt::format("{} --fail {}", PAWN_MOCK_UCI_ENGINE, failure)
+            : fmt::format("{} --fail {} --fail-marker {}",
+                  PAWN_MOCK_UCI_ENGINE,
+                  failure,
+                  marker.string());
+    }
+#ifdef __linux__
+    [[nodiscard]] std::vector<uint32_t> allowed_cpus(pid_t const pid)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        std::vector<uint32_t> rv;
+        if (sched_getaffinity(pid, sizeof(set), &set) == 0)
+        {
+            for (uint32_t cpu{}; cpu != CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &set))
+                {
+                    rv.push_back(cpu);
+                }
+            }
+        }
+        return rv;
+    }
+
+    // Running processes whose parent is the test process, from
+    // /proc/<pid>/stat. Engines which exited may not have been reaped yet.
+    [[nodiscard]] std::vector<int64_t> child_processes()
+    {
+        std::vector<int64_t> rv;
+        for (auto const& entry : std::filesystem::directory_iterator{"/proc"})
+        {
+            auto const pid{
+                pawn::parse_number<int64_t>(entry.path().filename().string())};
+            if (!pid)
+            {
+                continue;
+            }
+
+            std::ifstream stream{entry.path() / "stat"};
+            std::string const stat{std::istreambuf_iterator<char>{stream},
+                std::istreambuf_iterator<char>{}};
+
+            // The state and the parent follow the name
+            std::istringstream fields{stat.substr(stat.rfind(')') + 1)};
+            std::string state;
+            int64_t parent{};
+            if (fields >> state >> parent && parent == getpid() &&
+                state != "Z")
+            {
+                rv.push_back(*pid);
+            }
+        }
+        return rv;
+    }
+#endif
+} // namespace
+
+TEST_CASE("uci_engine watchdog", "[uci]")
+{
+    std::filesystem::path const marker{
+        std::filesystem::temp_directory_path() / "pawn_mock_uci_engine.failed"};
+    std::filesystem::remove(marker);
+
+    pawn::uci_reactor reactor;
+
+    SECTION("a stalled search is searched again by a restarted engine")
+    {
+        pawn::uci_engine engine{failing_engine("stall", marker),
+            reactor,
+            {},
+            watchdog};
+
+        std::optional<pawn::search_result> const result{
+            search(engine, timed_search)};
+        REQUIRE(result);
+        CHECK(result->move);
+
+        pawn::engine_health const health{engine.health()};
+        CHECK(health.stalls == 1);
+        CHECK(health.restarts == 1);
+        CHECK_FALSE(health.failed);
+    }
+
+    SECTION("an engine which exits while searching is restarted")
+    {
+        pawn::uci_engine engine{failing_engine("exit", marker),
+            reactor,
+            {},
+            watchdog};
+
+        std::optional<pawn::search_result> const result{
+            search(engine, timed_search)};
+        REQUIRE(result);
+        CHECK(result->move);
+
+        pawn::engine_health const health{engine.health()};
+        CHECK(health.stalls == 0);
+        CHECK(health.restarts == 1);
+        CHECK_FALSE(health.failed);
+
+        // The restarted engine keeps searching
+        std::optional<pawn::search_result> const next{
+            search(engine, timed_search)};
+        REQUIRE(next);
+        CHECK(next->move);
+        CHECK(engine.health().restarts == 1);
+    }
+
+    SECTION("settings are sent again to a restarted engine")
+    {
+        std::filesystem::path const path{
+            std::filesystem::temp_directory_path() /
+            "pawn_uci_engine_restart.ucilog"};
+        {
+            pawn::uci_recorder recorder{path};
+            pawn::uci_engine engine{failing_engine("exit", marker),
+                reactor,
+                {},
+                watchdog,
+                &recorder};
+            REQUIRE(engine.set_option("MultiPV", "3"));
+
+            std::optional<pawn::search_result> const result{
+                search(engine, timed_search)};
+            REQUIRE(result);
+            CHECK(result->move);
+        }
+
+        std::optional<std::vector<pawn::uci_record>> const records{
+            pawn::read_recording(path)};
+        REQUIRE(records);
+        CHECK(std::ranges::count_if(*records,
+                  [](pawn::uci_record const& record)
+                  {
+                      return record.direction == pawn::uci_direction::sent &&
+                          record.line == "setoption name MultiPV value 3";
+                  }) == 2);
+    }
+
+    SECTION("searches fail once the engine can't be restarted")
+    {
+        pawn::uci_engine engine{failing_engine("exit"),
+            reactor,
+            {},
+            {.heartbeat = watchdog.heartbeat,
+                .timeout = watchdog.timeout,
+                .max_restarts = 0}};
+
+        std::optional<pawn::search_result> const result{
+            search(engine, timed_search)};
+        REQUIRE(result);
+        CHECK_FALSE(result->move);
+
+        pawn::engine_health const health{engine.health()};
+        CHECK(health.restarts == 0);
+        CHECK(health.failed);
+
+        std::optional<pawn::search_result> const next{
+            search(engine, timed_search)};
+        REQUIRE(next);
+        CHECK_FALSE(next->move);
+    }
+}
+
+TEST_CASE("uci_engine pondering", "[uci]")
+{
+    pawn::uci_reactor reactor;
+    pawn::uci_engine engine{
+        PAWN_MOCK_UCI_ENGINE " --moves g1f3,d7d5 --think 10",
+        reactor};
+    // Searches requested during the handshake replace each other
+    engine.wait_until_ready();
+
+    SECTION("ponderhit completes the pondering search")
+    {
+        auto [callback, answer]{expect_result()};
+        engine.ponder(line({"e2e4", "e7e5"}),
+            timed_search,
+            std::move(callback));
+
+        // Pondering goes on until the expected move is played
+        CHECK(answer.wait_for(std::chrono::milliseconds{100}) ==
+            std::future_status::timeout);
+
+        engine.ponderhit();
+        std::optional<pawn::search_result> const result{wait_for(answer)};
+        REQUIRE(result);
+        CHECK(result->move->to_string() == "g1f3");
+        CHECK(result->ponder.to_string() == "d7d5");
+    }
+
+    SECTION("a ponder miss drops the pondering search")
+    {
+        std::atomic<bool> ponder_answered{false};
+        engine.ponder(line({"e2e4", "e7e5"}),
+            timed_search,
+            [&ponder_answered]([[maybe_unused]] pawn::search_result const&)
+            { ponder_answered = true; });
+
+        // The best move of the stopped search answers neither search
+        std::optional<pawn::search_result> const result{
+            search(engine, timed_search, line({"e2e4", "c7c5"}))};
+        REQUIRE(result);
+        CHECK(result->move->to_string() == "d7d5");
+
+        engine.synchronize();
+        CHECK_FALSE(ponder_answered);
+    }
+}
+
+TEST_CASE("uci_engine early pondering", "[uci]")
+{
+    pawn::uci_reactor reactor;
+    pawn::uci_engine engine{
+        PAWN_MOCK_UCI_ENGINE " --moves g1f3,d7d5 --ponder early",
+        reactor};
+    engine.wait_until_ready();
+
+    SECTION("a best move sent before ponderhit is held until it")
+    {
+        auto [callback, answer]{expect_result()};
+        engine.ponder(line({"e2e4", "e7e5"}),
+            timed_search,
+            std::move(callback));
+
+        // The engine answered at once
+        engine.synchronize();
+        CHECK(answer.wait_for(std::chrono::milliseconds{100}) ==
+            std::future_status::timeout);
+
+        auto const played{std::chrono::steady_clock::now()};
+        engine.ponderhit();
+        std::optional<pawn::search_result> const result{wait_for(answer)};
+        REQUIRE(result);
+        CHECK(result->move->to_string() == "g1f3");
+        CHECK(result->received >= played);
+    }
+
+    SECTION("a best move sent before a ponder miss is dropped")
+    {
+        std::atomic<bool> ponder_answered{false};
+        engine.ponder(line({"e2e4", "e7e5"}),
+            timed_search,
+            [&ponder_answered]([[maybe_unused]] pawn::search_result const&)
+            { ponder_answered = true; });
+        engine.synchronize();
+
+        std::optional<pawn::search_result> const result{
+            search(engine, timed_search, line({"e2e4", "c7c5"}))};
+        REQUIRE(result);
+        CHECK(result->move->to_string() == "d7d5");
+
+        engine.ponderhit();
+        engine.synchronize();
+        CHECK_FALSE(ponder_answered);
+    }
+}
+
+TEST_CASE("uci_engine latest info", "[uci]")
+{
+    pawn::uci_reactor reactor;
+    pawn::uci_engine engine{PAWN_MOCK_UCI_ENGINE " --info 5 --think 20",
+        reactor};
+    engine.wait_until_ready();
+
+    CHECK_FALSE(engine.take_latest_info());
+
+    SECTION("only the latest info line is taken")
+    {
+        REQUIRE(search(engine, {.depth = 5}));
+
+        std::optional<pawn::search_sample> const latest{
+            engine.take_latest_info()};
+        REQUIRE(latest);
+        CHECK(latest->info.depth == 5);
+        CHECK(latest->info.nodes == 4000);
+        CHECK_FALSE(engine.take_latest_info());
+    }
+
+    SECTION("infinite searches are followed until stopped")
+    {
+        auto [callback, answer]{expect_result()};
+        engine.next_move({}, {.infinite = true}, std::move(callback));
+
+        // Polled once per frame while the engine reports, the last line is
+        // depth 5
+        auto const deadline{
+            std::chrono::steady_clock::now() + std::chrono::seconds{10}};
+        std::optional<pawn::search_sample> latest;
+        while ((!latest || latest->info.depth != 5) &&
+            std::chrono::steady_clock::now() < deadline)
+        {
+            if (auto sample{engine.take_latest_info()})
+            {
+                latest = std::move(sample);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{16});
+        }
+        REQUIRE(latest);
+        CHECK(latest->info.depth == 5);
+        CHECK(engine.search_telemetry().empty());
+
+        engine.stop();
+        std::optional<pawn::search_result> const result{wait_for(answer)};
+        REQUIRE(result);
+        CHECK(result->move);
+    }
+}
+
+TEST_CASE("uci_engine search telemetry", "[uci]")
+{
+    pawn::uci_reactor reactor;
+    pawn::uci_engine engine{PAWN_MOCK_UCI_ENGINE " --info 4 --think 20",
+        reactor};
+    engine.wait_until_ready();
+
+    CHECK(engine.search_telemetry().empty());
+
+    auto const check_samples = [&engine]()
+    {
+        auto const started{std::chrono::steady_clock::now()};
+        std::optional<pawn::search_result> const result{
+            search(engine, {.depth = 4})};
+        auto const searched{std::chrono::steady_clock::now() - started};
+        REQUIRE(result);
+        CHECK(result->info.depth == 4);
+
+        std::vector<pawn::search_sample> const samples{
+            engine.search_telemetry()};
+        REQUIRE(samples.size() == 4);
+        for (size_t i{}; i != samples.size(); ++i)
+        {
+            CHECK(samples[i].info.depth == i + 1);
+            CHECK(samples[i].info.multipv == 1);
+            CHECK(samples[i].elapsed <= searched);
+            if (i != 0)
+            {
+                CHECK(samples[i - 1].elapsed <= samples[i].elapsed);
+            }
+        }
+    };
+
+    SECTION("each info line of a search is a sample")
+    {
+        check_samples();
+
+        // The samples of the previous search are replaced
+        check_samples();
+    }
+
+    SECTION("lines of the other variations aren't sampled")
+    {
+        REQUIRE(engine.set_option("MultiPV", "3"));
+        check_samples();
+    }
+}
+
+TEST_CASE("uci_engine process", "[uci]")
+{
+    pawn::uci_reactor reactor;
+
+    SECTION("the running engine process is sampled")
+    {
+        pawn::uci_engine engine{PAWN_MOCK_UCI_ENGINE, reactor};
+        engine.wait_until_ready();
+
+#ifdef __linux__
+        std::optional<pawn::process_usage> const usage{
+            engine.resource_usage()};
+        REQUIRE(usage);
+        CHECK(usage->resident_bytes > 0);
+        CHECK(usage->threads >= 1);
+#else
+        CHECK_FALSE(engine.resource_usage());
+#endif
+    }
+
+    SECTION("failed engines aren't sampled")
+    {
+        pawn::uci_engine engine{failing_engine("exit"),
+            reactor,
+            {},
+            {.heartbeat = watchdog.heartbeat,
+                .timeout = watchdog.timeout,
+                .max_restarts = 0}};
+        REQUIRE(search(engine, timed_search));
+        REQUIRE(engine.health().failed);
+
+        CHECK_FALSE(engine.resource_usage());
+        CHECK_FALSE(engine.set_affinity({0}));
+    }
+
+#ifdef __linux__
+    SECTION("the engine process and its threads are pinned")
+    {
+        pawn::uci_engine engine{PAWN_MOCK_UCI_ENGINE " --think 10", reactor};
+        engine.wait_until_ready();
+
+        // The first CPU available to the tests, usually CPU 0
+        uint32_t const cpu{allowed_cpus(getpid()).front()};
+        REQUIRE(engine.set_affinity({cpu}));
+
+        // The search thread is started after pinning
+        REQUIRE(search(engine, timed_search));
+
+        std::vector<int64_t> const children{child_processes()};
+        REQUIRE(children.size() == 1);
+
+        std::filesystem::path const tasks{
+            fmt::format("/proc/{}/task", children.front())};
+        for (auto const& task : std::filesystem::directory_iterator{tasks})
+        {
+            auto const tid{
+                pawn::parse_number<int64_t>(task.path().filename().string())};
+            REQUIRE(tid);
+            CHECK(allowed_cpus(static_cast<pid_t>(*tid)) ==
+                std::vector<uint32_t>{cpu});
+        }
+    }
+#endif
+}
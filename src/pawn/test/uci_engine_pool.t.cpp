@@ -0,0 +1,69 @@
+#include <uci_engine_pool.hpp>
+
+#include <search_limits.hpp>
+#include <uci_engine.hpp>
+#include <uci_reactor.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <vector>
+
+namespace
+{
+    constexpr char const* position{
+        "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"};
+
+    constexpr pawn::search_limits analysis{.depth = 10};
+
+    constexpr size_t engines{4};
+} // namespace
+
+TEST_CASE("uci_engine_pool", "[uci]")
+{
+    pawn::uci_reactor reactor;
+
+    // Each engine plays the moves of the script in order, the first move
+    // answers the first search of an engine
+    pawn::uci_engine_pool pool{
+        PAWN_MOCK_UCI_ENGINE " --think 20 --moves a2a3,b2b3,c2c3,d2d3",
+        reactor,
+        {.engines = engines}};
+    REQUIRE(pool.size() == engines);
+
+    SECTION("as many analyses as engines are searched by different engines")
+    {
+        std::vector<std::future<pawn::search_result>> results;
+        for (size_t i{}; i != engines; ++i)
+        {
+            results.push_back(pool.analyse(position, analysis));
+        }
+
+        for (std::future<pawn::search_result>& result : results)
+        {
+            REQUIRE(result.wait_for(std::chrono::seconds{10}) ==
+                std::future_status::ready);
+            pawn::search_result const searched{result.get()};
+            REQUIRE(searched.move);
+            CHECK(searched.move->to_string() == "a2a3");
+        }
+    }
+
+    SECTION("analyses queued beyond the engines all complete")
+    {
+        std::vector<std::future<pawn::search_result>> results;
+        for (size_t i{}; i != 3 * engines; ++i)
+        {
+            results.push_back(pool.analyse(position, analysis));
+        }
+
+        for (std::future<pawn::search_result>& result : results)
+        {
+            REQUIRE(result.wait_for(std::chrono::seconds{10}) ==
+                std::future_status::ready);
+            CHECK(result.get().move);
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include <uci_engine_standby.hpp>
+
+#include <engine_log.hpp>
+#include <engine_search.hpp>
+#include <search_limits.hpp>
+#include <uci_engine.hpp>
+#include <uci_reactor.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace asio = boost::asio;
+
+namespace
+{
+    // The script starts again with ucinewgame
+    constexpr char const* engine_command_line{
+        PAWN_MOCK_UCI_ENGINE " --moves a2a3,b2b3,c2c3"};
+
+    // Without the pings of the watchdog every isready is a request
+    constexpr pawn::uci_engine_standby_options no_standby{.profile = {},
+        .watchdog = {.heartbeat = std::chrono::milliseconds{}},
+        .standby = 0};
+
+    [[nodiscard]] std::optional<std::string> search(pawn::uci_engine& engine)
+    {
+        std::optional<pawn::search_result> const searched{
+            pawn::test::search(engine, {.depth = 1})};
+        if (!searched || !searched->move)
+        {
+            return std::nullopt;
+        }
+        return searched->move->to_string();
+    }
+
+    [[nodiscard]] std::vector<std::string> log_lines(pawn::uci_engine& engine)
+    {
+        pawn::engine_log& log{engine.log()};
+        static_cast<void>(log.update());
+
+        std::vector<std::string> rv;
+        for (size_t i{}; i != log.size(); ++i)
+        {
+            rv.emplace_back(log.line(i));
+        }
+        return rv;
+    }
+} // namespace
+
+TEST_CASE("uci_engine_standby", "[uci]")
+{
+    pawn::uci_reactor reactor;
+
+    SECTION("a released engine is reused after ucinewgame and isready")
+    {
+        pawn::uci_engine_standby standby{reactor, no_standby};
+
+        pawn::uci_engine engine{standby.acquire(engine_command_line)};
+        CHECK(search(engine) == "a2a3");
+        CHECK(search(engine) == "b2b3");
+        uint64_t const answered{engine.health().isready_latency.count()};
+        standby.release(std::move(engine));
+
+        // The history of the first game is kept by the same engine
+        pawn::uci_engine reused{standby.acquire(engine_command_line)};
+        CHECK(log_lines(reused).back() == "bestmove b2b3 ponder c2c3");
+        CHECK(reused.health().isready_latency.count() == answered + 1);
+
+        CHECK(search(reused) == "a2a3");
+    }
+
+    SECTION("engines are reused by coroutines too")
+    {
+        pawn::uci_engine_standby standby{reactor, no_standby};
+
+        pawn::uci_engine engine{standby.acquire(engine_command_line)};
+        CHECK(search(engine) == "a2a3");
+        uint64_t const answered{engine.health().isready_latency.count()};
+        standby.release(std::move(engine));
+
+        // Engines aren't default constructible, co_spawn can't complete
+        // with one
+        std::optional<pawn::uci_engine> reused;
+        asio::io_context context{1};
+        asio::co_spawn(
+            context,
+            [&standby, &reused]() -> asio::awaitable<void>
+            {
+                reused.emplace(
+                    co_await standby.async_acquire(engine_command_line));
+            },
+            asio::detached);
+        context.run();
+
+        REQUIRE(reused);
+        CHECK(log_lines(*reused).back() == "bestmove a2a3 ponder b2b3");
+        CHECK(reused->health().isready_latency.count() == answered + 1);
+        CHECK(search(*reused) == "a2a3");
+    }
+
+    SECTION("standby engines are handed out after their handshake")
+    {
+        pawn::uci_engine_standby standby{reactor,
+            {.profile = {}, .watchdog = {}, .standby = 1}};
+
+        // Starts the standby engine, which completes its handshake while the
+        // first one searches
+        pawn::uci_engine first{standby.acquire(engine_command_line)};
+        CHECK(search(first) == "a2a3");
+
+        pawn::uci_engine second{standby.acquire(engine_command_line)};
+        CHECK(second.ready());
+
+        std::vector<std::string> const lines{log_lines(second)};
+        CHECK(std::ranges::find(lines, std::string_view{"uciok"}) !=
+            lines.end());
+        CHECK(search(second) == "a2a3");
+    }
+}
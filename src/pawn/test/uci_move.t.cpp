@@ -0,0 +1,65 @@
+#include <uci_move.hpp>
+
+#include <chess.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <optional>
+#include <string_view>
+
+static_assert(pawn::parse_move("e2e4")->from() == 12);
+static_assert(pawn::parse_move("e2e4")->to() == 28);
+static_assert(pawn::parse_move("h7h8q")->promotion() ==
+    pawn::piece_type::queen);
+static_assert(pawn::parse_move("0000")->null());
+static_assert(!pawn::parse_move("e2e9"));
+static_assert(!pawn::parse_move("e7e8k"));
+
+TEST_CASE("uci_move", "[uci]")
+{
+    SECTION("round trip")
+    {
+        for (std::string_view const notation : {"a1h8",
+                 "h8a1",
+                 "e2e4",
+                 "g1f3",
+                 "a7a8n",
+                 "b2b1b",
+                 "c7c8r",
+                 "h7h8q"})
+        {
+            std::optional<pawn::uci_move> const move{
+                pawn::parse_move(notation)};
+            REQUIRE(move);
+            CHECK_FALSE(move->null());
+            CHECK(move->to_string() == notation);
+        }
+    }
+
+    SECTION("null move")
+    {
+        pawn::uci_move const move;
+        CHECK(move.null());
+        CHECK(move.to_string() == "0000");
+        CHECK(pawn::parse_move("0000") == move);
+    }
+
+    SECTION("fields")
+    {
+        pawn::uci_move const move{52, 60, pawn::piece_type::knight};
+        CHECK(move.from() == 52);
+        CHECK(move.to() == 60);
+        CHECK(move.promotion() == pawn::piece_type::knight);
+        CHECK(move.to_string() == "e7e8n");
+        CHECK(move != pawn::uci_move{52, 60});
+    }
+
+    SECTION("invalid notation")
+    {
+        for (std::string_view const notation :
+            {"", "e2", "e2e4e", "i2e4", "e0e4", "e2e4qq", "(none)", "0000q"})
+        {
+            CHECK_FALSE(pawn::parse_move(notation));
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#include <uci_options.hpp>
+#include <uci_parser.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+using namespace std::string_literals;
+
+TEST_CASE("uci_options", "[uci]")
+{
+    pawn::uci_options options;
+    options.add({.name = "Threads",
+        .type = pawn::ast::option_type::spin,
+        .def = "1"s,
+        .min_max = std::pair<int64_t, int64_t>{1, 1024},
+        .values = {}});
+    options.add({.name = "Ponder",
+        .type = pawn::ast::option_type::check,
+        .def = "false"s,
+        .min_max = {},
+        .values = {}});
+    options.add({.name = "Style",
+        .type = pawn::ast::option_type::combo,
+        .def = "Normal"s,
+        .min_max = {},
+        .values = {"Solid", "Normal", "Risky"}});
+    options.add({.name = "Clear Hash",
+        .type = pawn::ast::option_type::button,
+        .def = {},
+        .min_max = {},
+        .values = {}});
+
+    SECTION("find is case insensitive")
+    {
+        REQUIRE(options.find("threads"));
+        CHECK(options.find("threads")->name == "Threads");
+        CHECK_FALSE(options.find("Hash"));
+    }
+
+    SECTION("validate")
+    {
+        auto const threads{options.validate("threads", "8")};
+        REQUIRE(threads);
+        CHECK(threads->name == "Threads");
+        CHECK(threads->value == "8");
+
+        CHECK(options.validate("Threads", "4096")->value == "1024");
+        CHECK(options.validate("Threads", "0")->value == "1");
+        CHECK_FALSE(options.validate("Threads", "many"));
+
+        CHECK(options.validate("Ponder", "TRUE")->value == "true");
+        CHECK_FALSE(options.validate("Ponder", "yes"));
+
+        CHECK(options.validate("Style", "risky")->value == "Risky");
+        CHECK_FALSE(options.validate("Style", "Wild"));
+
+        CHECK(options.validate("Clear Hash", "")->value.empty());
+        CHECK_FALSE(options.validate("Hash", "16"));
+    }
+
+    SECTION("profile skips undeclared options")
+    {
+        options.add({.name = "Move Overhead",
+            .type = pawn::ast::option_type::spin,
+            .def = "10"s,
+            .min_max = std::pair<int64_t, int64_t>{0, 5000},
+            .values = {}});
+
+        auto const settings{options.resolve({.threads = 2048,
+            .hash = 256,
+            .move_overhead = std::chrono::milliseconds{50}})};
+        REQUIRE(settings.size() == 2);
+        CHECK(settings[0].name == "Threads");
+        CHECK(settings[0].value == "1024");
+        CHECK(settings[1].name == "Move Overhead");
+        CHECK(settings[1].value == "50");
+    }
+}
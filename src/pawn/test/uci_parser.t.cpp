@@ -195,4 +195,124 @@ TEST_CASE("bestmove", "[uci]")
         CHECK(bestmove.move == "e1e2");
         CHECK(bestmove.ponder.empty());
     }
+
+    SECTION("without legal moves")
+    {
+        auto const string{"bestmove (none)"sv};
+        auto iter{string.cbegin()};
+
+        pawn::ast::bestmove bestmove;
+        CHECK(phrase_parse(iter,
+            string.cend(),
+            pawn::bestmove(),
+            space,
+            bestmove));
+        CHECK(iter == string.cend());
+        CHECK(bestmove.move == "(none)");
+    }
+}
+
+TEST_CASE("info", "[uci]")
+{
+    using namespace std::string_view_literals;
+
+    using boost::spirit::x3::ascii::space;
+
+    SECTION("search progress")
+    {
+        auto const string{
+            "info depth 20 seldepth 27 multipv 1 score cp 31 nodes 1095340 nps 1032367 hashfull 417 tbhits 0 time 1061 pv e2e4 e7e5 g1f3 b8c6"sv};
+        auto iter{string.cbegin()};
+
+        pawn::ast::info info{};
+        CHECK(phrase_parse(iter, string.cend(), pawn::info(), space, info));
+        CHECK(iter == string.cend());
+        CHECK(info.depth == 20);
+        CHECK(info.seldepth == 27);
+        CHECK(info.multipv == 1);
+        CHECK(has_field(info, pawn::ast::info_field::score));
+        CHECK(info.score.value == 31);
+        CHECK_FALSE(info.score.mate);
+        CHECK(info.nodes == 1095340);
+        CHECK(info.nps == 1032367);
+        CHECK(info.hashfull == 417);
+        CHECK(info.tbhits == 0);
+        CHECK(has_field(info, pawn::ast::info_field::tbhits));
+        CHECK(info.time == 1061);
+        REQUIRE(info.pv_length == 4);
+        CHECK(info.pv[0].to_string() == "e2e4");
+        CHECK(info.pv[3].to_string() == "b8c6");
+        CHECK_FALSE(has_field(info, pawn::ast::info_field::currmove));
+    }
+
+    SECTION("mate score with bound and promotion")
+    {
+        auto const string{
+            "info depth 3 score mate -2 upperbound wdl 0 0 1000 pv a7a8q"sv};
+        auto iter{string.cbegin()};
+
+        pawn::ast::info info{};
+        CHECK(phrase_parse(iter, string.cend(), pawn::info(), space, info));
+        CHECK(iter == string.cend());
+        CHECK(info.score.value == -2);
+        CHECK(info.score.mate);
+        CHECK(info.score.upperbound);
+        CHECK_FALSE(info.score.lowerbound);
+        CHECK(info.wdl == std::array<uint32_t, 3>{0, 0, 1000});
+        REQUIRE(info.pv_length == 1);
+        CHECK(info.pv[0].to_string() == "a7a8q");
+    }
+
+    SECTION("current move")
+    {
+        auto const string{"info depth 5 currmove e2e4 currmovenumber 1"sv};
+        auto iter{string.cbegin()};
+
+        pawn::ast::info info{};
+        CHECK(phrase_parse(iter, string.cend(), pawn::info(), space, info));
+        CHECK(iter == string.cend());
+        CHECK(info.currmove.to_string() == "e2e4");
+        CHECK(info.currmovenumber == 1);
+        CHECK_FALSE(has_field(info, pawn::ast::info_field::pv));
+    }
+
+    SECTION("string")
+    {
+        auto const string{
+            "info string NNUE evaluation using nn-b1a57edbea57.nnue enabled"sv};
+        auto iter{string.cbegin()};
+
+        pawn::ast::info info{};
+        CHECK(phrase_parse(iter, string.cend(), pawn::info(), space, info));
+        CHECK(iter == string.cend());
+        CHECK(info.fields == pawn::ast::info_field::string_);
+    }
+
+    SECTION("unknown tokens are skipped")
+    {
+        auto const string{"info depth 7 ebf 1.5 nodes 100"sv};
+        auto iter{string.cbegin()};
+
+        pawn::ast::info info{};
+        CHECK(phrase_parse(iter, string.cend(), pawn::info(), space, info));
+        CHECK(iter == string.cend());
+        CHECK(info.depth == 7);
+        CHECK(info.nodes == 100);
+    }
+
+    SECTION("long principal variation is truncated")
+    {
+        std::string string{"info depth 99 pv"};
+        for (size_t i{}; i != pawn::ast::info::max_pv_length + 10; ++i)
+        {
+            string += i % 2 == 0 ? " g1f3" : " f3g1";
+        }
+        std::string_view const view{string};
+        auto iter{view.cbegin()};
+
+        pawn::ast::info info{};
+        CHECK(phrase_parse(iter, view.cend(), pawn::info(), space, info));
+        CHECK(iter == view.cend());
+        CHECK(info.pv_length == pawn::ast::info::max_pv_length);
+    }
 }
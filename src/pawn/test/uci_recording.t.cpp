@@ -0,0 +1,68 @@
+#include <uci_recording.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+TEST_CASE("uci_recording", "[uci]")
+{
+    std::filesystem::path const path{
+        std::filesystem::temp_directory_path() / "pawn_uci_recording.ucilog"};
+
+    {
+        pawn::uci_recorder recorder{path};
+        recorder.record(pawn::uci_direction::sent, "uci");
+        recorder.record(pawn::uci_direction::received, "id name Stockfish");
+        recorder.record(pawn::uci_direction::received, "");
+        recorder.record(pawn::uci_direction::received,
+            std::string(300, 'x'));
+        recorder.record(pawn::uci_direction::sent, "quit");
+    }
+
+    SECTION("records are read back in order")
+    {
+        std::optional<std::vector<pawn::uci_record>> const records{
+            pawn::read_recording(path)};
+        REQUIRE(records);
+        REQUIRE(records->size() == 5);
+
+        CHECK((*records)[0].direction == pawn::uci_direction::sent);
+        CHECK((*records)[0].line == "uci");
+        CHECK((*records)[1].direction == pawn::uci_direction::received);
+        CHECK((*records)[1].line == "id name Stockfish");
+        CHECK((*records)[2].line.empty());
+        CHECK((*records)[3].line == std::string(300, 'x'));
+        CHECK((*records)[4].line == "quit");
+
+        for (size_t i{1}; i != records->size(); ++i)
+        {
+            CHECK((*records)[i - 1].timestamp <= (*records)[i].timestamp);
+        }
+    }
+
+    SECTION("truncated record is dropped")
+    {
+        std::ifstream stream{path, std::ios::binary};
+        std::string bytes{std::istreambuf_iterator<char>{stream}, {}};
+        bytes.resize(bytes.size() - 2);
+
+        std::optional<std::vector<pawn::uci_record>> const records{
+            pawn::parse_recording(bytes)};
+        REQUIRE(records);
+        CHECK(records->size() == 4);
+    }
+
+    SECTION("other files are rejected")
+    {
+        CHECK_FALSE(pawn::parse_recording("uci\nuciok\n"));
+        CHECK_FALSE(pawn::read_recording(path.string() + ".missing"));
+    }
+
+    std::filesystem::remove(path);
+}
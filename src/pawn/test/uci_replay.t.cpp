@@ -0,0 +1,123 @@
+#include <uci_replay.hpp>
+
+#include <uci_recording.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    [[nodiscard]] pawn::uci_record sent(std::chrono::microseconds const at,
+        std::string line)
+    {
+        return {.direction = pawn::uci_direction::sent,
+            .timestamp = at,
+            .line = std::move(line)};
+    }
+
+    [[nodiscard]] pawn::uci_record received(
+        std::chrono::microseconds const at,
+        std::string line)
+    {
+        return {.direction = pawn::uci_direction::received,
+            .timestamp = at,
+            .line = std::move(line)};
+    }
+
+    [[nodiscard]] std::vector<std::string_view> lines(
+        std::vector<pawn::uci_replay_line> const& replayed)
+    {
+        std::vector<std::string_view> rv;
+        for (pawn::uci_replay_line const& line : replayed)
+        {
+            rv.push_back(line.line);
+        }
+        return rv;
+    }
+} // namespace
+
+TEST_CASE("uci_replay", "[uci]")
+{
+    pawn::uci_replay replay{{received(1ms, "Stockfish by the developers"),
+        sent(2ms, "uci"),
+        received(3ms, "id name Stockfish"),
+        received(5ms, "uciok"),
+        sent(10ms, "isready"),
+        received(11ms, "readyok"),
+        sent(20ms, "go depth 1"),
+        received(25ms, "info depth 1"),
+        received(70ms, "bestmove e2e4"),
+        sent(80ms, "quit")}};
+
+    std::vector<pawn::uci_replay_line> const banner{replay.start()};
+    REQUIRE(banner.size() == 1);
+    CHECK(banner[0].line == "Stockfish by the developers");
+    CHECK(banner[0].delay == 1ms);
+
+    SECTION("commands are answered in order with the recorded delays")
+    {
+        pawn::uci_replay_answer const handshake{replay.receive("uci")};
+        CHECK_FALSE(handshake.expected);
+        REQUIRE(handshake.lines.size() == 2);
+        CHECK(handshake.lines[0].line == "id name Stockfish");
+        CHECK(handshake.lines[0].delay == 1ms);
+        CHECK(handshake.lines[1].line == "uciok");
+        CHECK(handshake.lines[1].delay == 3ms);
+
+        pawn::uci_replay_answer const search{replay.receive("go depth 1")};
+        CHECK_FALSE(search.expected);
+        REQUIRE(search.lines.size() == 2);
+        CHECK(search.lines[0].delay == 5ms);
+        CHECK(search.lines[1].line == "bestmove e2e4");
+        CHECK(search.lines[1].delay == 50ms);
+
+        pawn::uci_replay_answer const quit{replay.receive("quit")};
+        CHECK_FALSE(quit.expected);
+        CHECK(quit.lines.empty());
+    }
+
+    SECTION("pings are answered directly")
+    {
+        for (int i{}; i != 3; ++i)
+        {
+            pawn::uci_replay_answer const ping{replay.receive("isready")};
+            CHECK_FALSE(ping.expected);
+            CHECK(lines(ping.lines) ==
+                std::vector<std::string_view>{"readyok"});
+            CHECK(ping.lines[0].delay == 0ms);
+        }
+
+        // The recorded ping doesn't take the place of a command
+        CHECK(lines(replay.receive("uci").lines) ==
+            std::vector<std::string_view>{"id name Stockfish", "uciok"});
+        CHECK(lines(replay.receive("go depth 1").lines) ==
+            std::vector<std::string_view>{"info depth 1", "bestmove e2e4"});
+    }
+
+    SECTION("another command is answered as the recorded one")
+    {
+        pawn::uci_replay_answer const answer{replay.receive("debug on")};
+        REQUIRE(answer.expected);
+        CHECK(*answer.expected == "uci");
+        CHECK(lines(answer.lines) ==
+            std::vector<std::string_view>{"id name Stockfish", "uciok"});
+    }
+
+    SECTION("nothing is answered past the recording")
+    {
+        static_cast<void>(replay.receive("uci"));
+        static_cast<void>(replay.receive("go depth 1"));
+        static_cast<void>(replay.receive("quit"));
+
+        pawn::uci_replay_answer const answer{replay.receive("go depth 2")};
+        CHECK_FALSE(answer.expected);
+        CHECK(answer.lines.empty());
+    }
+}
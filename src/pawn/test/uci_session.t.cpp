@@ -0,0 +1,176 @@
+#include <uci_session.hpp>
+
+#include <search_limits.hpp>
+#include <uci_engine.hpp>
+#include <uci_move.hpp>
+#include <uci_reactor.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace asio = boost::asio;
+
+namespace
+{
+    constexpr pawn::search_limits search{.depth = 1};
+
+    [[nodiscard]] asio::awaitable<std::vector<pawn::search_result>> play(
+        pawn::uci_session& session,
+        size_t const searches)
+    {
+        std::vector<pawn::search_result> rv;
+        std::vector<pawn::uci_move> moves;
+        for (size_t i{}; i != searches; ++i)
+        {
+            rv.push_back(co_await session.go(moves, search));
+            moves.push_back(rv.back().move.value_or(pawn::uci_move{}));
+        }
+        co_return rv;
+    }
+
+    // Counts the samples until next_info completes empty
+    [[nodiscard]] asio::awaitable<size_t> follow(pawn::uci_session& session)
+    {
+        size_t rv{};
+        while (co_await session.next_info())
+        {
+            ++rv;
+        }
+        co_return rv;
+    }
+
+    [[nodiscard]] asio::awaitable<void> search_concurrently(
+        pawn::uci_session& session,
+        size_t& searching,
+        size_t& most_searching,
+        std::thread::id& resumed_on)
+    {
+        for (size_t i{}; i != 3; ++i)
+        {
+            most_searching = std::max(most_searching, ++searching);
+            pawn::search_result const result{co_await session.go({}, search)};
+            --searching;
+
+            resumed_on = std::this_thread::get_id();
+            CHECK(result.move);
+        }
+    }
+} // namespace
+
+TEST_CASE("uci_session", "[uci]")
+{
+    pawn::uci_reactor reactor;
+    asio::io_context context{1};
+
+    SECTION("searches complete with the moves of the engine")
+    {
+        pawn::uci_engine engine{PAWN_MOCK_UCI_ENGINE " --moves e2e4,e7e5,g1f3",
+            reactor};
+        pawn::uci_session session{engine};
+
+        auto results{asio::co_spawn(context,
+            play(session, 2),
+            asio::use_future)};
+        context.run();
+
+        std::vector<pawn::search_result> const played{results.get()};
+        REQUIRE(played.size() == 2);
+        CHECK(played[0].move->to_string() == "e2e4");
+        CHECK(played[0].ponder.to_string() == "e7e5");
+        CHECK(played[1].move->to_string() == "e7e5");
+        CHECK(played[1].ponder.to_string() == "g1f3");
+        CHECK(played[0].received <= played[1].received);
+    }
+
+    SECTION("isready and new_game complete once the engine answers")
+    {
+        pawn::uci_engine engine{PAWN_MOCK_UCI_ENGINE, reactor};
+        pawn::uci_session session{engine};
+
+        auto ready{asio::co_spawn(
+            context,
+            [&session]() -> asio::awaitable<bool>
+            {
+                co_await session.isready();
+                bool const handshake_completed{session.engine().ready()};
+                co_await session.new_game();
+                pawn::search_result const result{
+                    co_await session.go({}, search)};
+                co_return handshake_completed && result.move;
+            },
+            asio::use_future)};
+        context.run();
+
+        CHECK(ready.get());
+    }
+
+    SECTION("info lines are followed until the best move")
+    {
+        pawn::uci_engine engine{PAWN_MOCK_UCI_ENGINE " --info 5 --think 50",
+            reactor};
+        pawn::uci_session session{engine};
+
+        // The search is started before the info lines are requested
+        auto results{asio::co_spawn(context,
+            play(session, 1),
+            asio::use_future)};
+        auto samples{
+            asio::co_spawn(context, follow(session), asio::use_future)};
+        context.run();
+
+        REQUIRE(results.get().size() == 1);
+        CHECK(samples.get() >= 1);
+
+        // Without a search in progress next_info completes empty at once
+        context.restart();
+        auto after{asio::co_spawn(context,
+            session.next_info(),
+            asio::use_future)};
+        context.run();
+        CHECK_FALSE(after.get());
+    }
+
+    SECTION("sessions share the thread running the io_context")
+    {
+        pawn::uci_engine first_engine{PAWN_MOCK_UCI_ENGINE " --think 20",
+            reactor};
+        pawn::uci_engine second_engine{PAWN_MOCK_UCI_ENGINE " --think 20",
+            reactor};
+        pawn::uci_session first{first_engine};
+        pawn::uci_session second{second_engine};
+
+        size_t searching{};
+        size_t most_searching{};
+        std::thread::id first_resumed_on;
+        std::thread::id second_resumed_on;
+        asio::co_spawn(context,
+            search_concurrently(first,
+                searching,
+                most_searching,
+                first_resumed_on),
+            asio::detached);
+        asio::co_spawn(context,
+            search_concurrently(second,
+                searching,
+                most_searching,
+                second_resumed_on),
+            asio::detached);
+        context.run();
+
+        CHECK(searching == 0);
+        CHECK(most_searching == 2);
+        CHECK(first_resumed_on == std::this_thread::get_id());
+        CHECK(second_resumed_on == std::this_thread::get_id());
+    }
+}
@@ -0,0 +1,205 @@
+#include <uci_tokenizer.hpp>
+
+#include <uci_ast.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+TEST_CASE("uci_tokenizer", "[uci]")
+{
+    pawn::uci_tokenizer tokens{"  go\tdepth  10 \r\n"};
+    CHECK(tokens.next() == "go");
+    CHECK(tokens.rest() == "depth  10");
+    CHECK(tokens.next() == "depth");
+    CHECK(tokens.next() == "10");
+    CHECK(tokens.next().empty());
+    CHECK(tokens.rest().empty());
+}
+
+TEST_CASE("classify", "[uci]")
+{
+    using pawn::uci_message;
+
+    auto const classify = [](std::string_view const line)
+    {
+        pawn::uci_tokenizer tokens{line};
+        return pawn::classify(tokens);
+    };
+
+    CHECK(classify("id name Stockfish") == uci_message::id);
+    CHECK(classify("uciok\r\n") == uci_message::uciok);
+    CHECK(classify("readyok") == uci_message::readyok);
+    CHECK(classify("bestmove e2e4") == uci_message::bestmove);
+    CHECK(classify("copyprotection ok") == uci_message::copyprotection);
+    CHECK(classify("registration error") == uci_message::registration);
+    CHECK(classify("info depth 1") == uci_message::info);
+    CHECK(classify("option name Hash type spin") == uci_message::option);
+    CHECK(classify("information") == uci_message::unknown);
+    CHECK(classify("  ") == uci_message::unknown);
+
+    pawn::uci_tokenizer tokens{"registration checking"};
+    REQUIRE(pawn::classify(tokens) == uci_message::registration);
+    CHECK(pawn::parse_status(tokens) == pawn::ast::status::checking);
+    CHECK_FALSE(pawn::parse_status(pawn::uci_tokenizer{"unknown"}));
+}
+
+TEST_CASE("parse_id", "[uci]")
+{
+    auto const id{
+        pawn::parse_id("id author the Stockfish developers (see AUTHORS)\n")};
+    REQUIRE(id);
+    CHECK(id->key == "author");
+    CHECK(id->value == "the Stockfish developers (see AUTHORS)");
+
+    CHECK_FALSE(pawn::parse_id("id version 1"));
+    CHECK_FALSE(pawn::parse_id("identity name x"));
+}
+
+TEST_CASE("parse_option", "[uci]")
+{
+    SECTION("spin")
+    {
+        auto const option{pawn::parse_option(
+            "option name Skill Level type spin default 20 min 0 max 20")};
+        REQUIRE(option);
+        CHECK(option->name == "Skill Level");
+        CHECK(option->type == pawn::ast::option_type::spin);
+        CHECK(option->def == "20");
+        CHECK(option->min_max == std::pair<int64_t, int64_t>{0, 20});
+        CHECK(option->values_length == 0);
+    }
+
+    SECTION("combo")
+    {
+        using namespace std::string_literals;
+
+        auto const option{pawn::parse_option("option name Style type combo "
+                                             "default Normal var Solid var "
+                                             "Normal var Risky\n")};
+        REQUIRE(option);
+
+        pawn::ast::option const converted{pawn::to_option(*option)};
+        CHECK(converted.name == "Style");
+        CHECK(converted.type == pawn::ast::option_type::combo);
+        CHECK(converted.def.get_value_or("") == "Normal");
+        CHECK_FALSE(converted.min_max.has_value());
+        CHECK(converted.values ==
+            std::vector{"Solid"s, "Normal"s, "Risky"s});
+    }
+
+    SECTION("button")
+    {
+        auto const option{
+            pawn::parse_option("option name Clear Hash type button")};
+        REQUIRE(option);
+        CHECK(option->name == "Clear Hash");
+        CHECK(option->type == pawn::ast::option_type::button);
+        CHECK_FALSE(option->def);
+    }
+
+    SECTION("malformed")
+    {
+        CHECK_FALSE(pawn::parse_option("option name Hash"));
+        CHECK_FALSE(pawn::parse_option("option name Hash type integer"));
+        CHECK_FALSE(pawn::parse_option("option name type check"));
+        CHECK_FALSE(
+            pawn::parse_option("option name Hash type spin min 1 max x"));
+    }
+}
+
+TEST_CASE("parse_bestmove", "[uci]")
+{
+    auto const with_ponder{pawn::parse_bestmove("bestmove e1e2 ponder e3e4")};
+    REQUIRE(with_ponder);
+    CHECK(with_ponder->move.to_string() == "e1e2");
+    CHECK(with_ponder->ponder.to_string() == "e3e4");
+
+    auto const without_legal_moves{pawn::parse_bestmove("bestmove (none)")};
+    REQUIRE(without_legal_moves);
+    CHECK(without_legal_moves->move.null());
+    CHECK(without_legal_moves->ponder.null());
+
+    CHECK_FALSE(pawn::parse_bestmove("bestmove"));
+    CHECK_FALSE(pawn::parse_bestmove("bestmove e2e9"));
+}
+
+TEST_CASE("parse_info", "[uci]")
+{
+    pawn::ast::info info{};
+
+    SECTION("search progress")
+    {
+        REQUIRE(pawn::parse_info(
+            "info depth 20 seldepth 27 multipv 1 score cp 31 nodes 1095340 "
+            "nps 1032367 hashfull 417 tbhits 0 time 1061 pv e2e4 e7e5 g1f3",
+            info));
+        CHECK(info.depth == 20);
+        CHECK(info.seldepth == 27);
+        CHECK(info.multipv == 1);
+        CHECK(info.score.value == 31);
+        CHECK_FALSE(info.score.mate);
+        CHECK(info.nodes == 1095340);
+        CHECK(info.nps == 1032367);
+        CHECK(info.hashfull == 417);
+        CHECK(has_field(info, pawn::ast::info_field::tbhits));
+        CHECK(info.time == 1061);
+        REQUIRE(info.pv_length == 3);
+        CHECK(info.pv[2].to_string() == "g1f3");
+    }
+
+    SECTION("previous line is reset")
+    {
+        REQUIRE(pawn::parse_info("info depth 3 score mate -2 upperbound "
+                                 "wdl 0 0 1000 pv a7a8q",
+            info));
+        CHECK(info.score.mate);
+        CHECK(info.score.upperbound);
+        CHECK(info.wdl == std::array<uint32_t, 3>{0, 0, 1000});
+        CHECK(info.pv[0].to_string() == "a7a8q");
+
+        REQUIRE(pawn::parse_info("info depth 5 currmove e2e4 currmovenumber 1",
+            info));
+        CHECK(info.currmove.to_string() == "e2e4");
+        CHECK(info.currmovenumber == 1);
+        CHECK_FALSE(info.score.mate);
+        CHECK_FALSE(has_field(info, pawn::ast::info_field::score));
+        CHECK_FALSE(has_field(info, pawn::ast::info_field::pv));
+    }
+
+    SECTION("unknown and malformed items are skipped")
+    {
+        REQUIRE(pawn::parse_info(
+            "info depth x ebf 1.5 nodes 100 score inf currline 1 e2e4 e7e5",
+            info));
+        CHECK(info.fields ==
+            (pawn::ast::info_field::nodes | pawn::ast::info_field::currline));
+        CHECK(info.nodes == 100);
+    }
+
+    SECTION("string")
+    {
+        REQUIRE(pawn::parse_info("info string depth 10 pv e2e4", info));
+        CHECK(info.fields == pawn::ast::info_field::string_);
+    }
+
+    SECTION("long principal variation is truncated")
+    {
+        std::string line{"info depth 99 pv"};
+        for (size_t i{}; i != pawn::ast::info::max_pv_length + 10; ++i)
+        {
+            line += i % 2 == 0 ? " g1f3" : " f3g1";
+        }
+
+        REQUIRE(pawn::parse_info(line, info));
+        CHECK(info.pv_length == pawn::ast::info::max_pv_length);
+    }
+
+    CHECK_FALSE(pawn::parse_info("bestmove e2e4", info));
+}